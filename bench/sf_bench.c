@@ -0,0 +1,612 @@
+#include <sionflow/engine/sf_engine.h>
+#include <sionflow/isa/sf_program.h>
+#include <sionflow/isa/sf_backend.h>
+#include <sionflow/base/sf_log.h>
+#include <sionflow/base/sf_utils.h>
+#include <sionflow/base/sf_json.h>
+#include <sionflow/base/sf_memory.h>
+#include "sf_loader.h"
+#include "sf_codec.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/**
+ * sf_bench: reproducible microbenchmarks of the runtime's hot and setup paths.
+ *
+ * All inputs are generated in-process (synthetic programs, pipelines, cartridges and
+ * images), kernels run on a no-op backend so only engine overhead is measured.
+ * Results are written as JSON and can be compared against a saved baseline:
+ *
+ *   sf_bench [--out results.json] [--baseline base.json] [--threshold 0.10]
+ *            [--threshold-for name=0.25] [--filter name] [--quick]
+ *
+ * Exits with 2 when any benchmark is slower than baseline * (1 + threshold).
+ */
+
+#define SF_BENCH_MAX_RESULTS    32
+#define SF_BENCH_MAX_OVERRIDES  16
+#define SF_BENCH_REPEATS        5
+#define SF_BENCH_TMP_CART       "sf_bench_cart.sfc"
+#define SF_BENCH_TMP_IMAGE      "sf_bench_image.bmp"
+
+typedef struct {
+    char   name[64];
+    u64    iterations;
+    double ns_per_op;  // Best of SF_BENCH_REPEATS
+    double total_ms;   // Sum over all repeats
+} sf_bench_result;
+
+typedef struct {
+    const char* name;
+    double      threshold;
+} sf_bench_override;
+
+typedef struct {
+    sf_bench_result   results[SF_BENCH_MAX_RESULTS];
+    u32               result_count;
+    const char*       filter;
+    bool              quick;
+} sf_bench_ctx;
+
+// --- Timing ---
+
+static double _now_ns(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec * 1.0e9 + (double)ts.tv_nsec;
+}
+
+typedef void (*sf_bench_fn)(void* user_data, u64 iterations);
+
+static void _run(sf_bench_ctx* ctx, const char* name, u64 iterations, sf_bench_fn fn, void* user_data) {
+    if (ctx->filter && !strstr(name, ctx->filter)) return;
+    if (ctx->result_count >= SF_BENCH_MAX_RESULTS) return;
+    if (ctx->quick) iterations = iterations / 10 ? iterations / 10 : 1;
+
+    fn(user_data, iterations > 10 ? iterations / 10 : 1); // Warm-up
+
+    sf_bench_result* r = &ctx->results[ctx->result_count++];
+    snprintf(r->name, sizeof(r->name), "%s", name);
+    r->iterations = iterations;
+    r->ns_per_op = 0.0;
+    r->total_ms = 0.0;
+    for (int rep = 0; rep < SF_BENCH_REPEATS; ++rep) {
+        double t0 = _now_ns();
+        fn(user_data, iterations);
+        double dt = _now_ns() - t0;
+        double per_op = dt / (double)iterations;
+        if (rep == 0 || per_op < r->ns_per_op) r->ns_per_op = per_op;
+        r->total_ms += dt / 1.0e6;
+    }
+    printf("%-28s %12.1f ns/op  (%llu iterations)\n", r->name, r->ns_per_op, (unsigned long long)iterations);
+}
+
+// --- No-op Backend ---
+
+static void _noop_dispatch(void* backend_state, const sf_program* program, sf_state* state, const sf_tensor* domain, const sf_task* task) {
+    (void)backend_state; (void)program; (void)state; (void)domain; (void)task;
+}
+
+static sf_engine* _create_batched_engine(u32 batch_size) {
+    sf_backend backend;
+    memset(&backend, 0, sizeof(backend));
+    backend.dispatch = _noop_dispatch;
+
+    sf_engine_desc desc;
+    memset(&desc, 0, sizeof(desc));
+    desc.arena_size = SF_MB(64);
+    desc.heap_size = SF_MB(256);
+    desc.backend = backend;
+    desc.batch_size = batch_size;
+    return sf_engine_create(&desc);
+}
+
+static sf_engine* _create_engine(void) {
+    return _create_batched_engine(1);
+}
+
+// --- Synthetic Programs ---
+
+/**
+ * A chain of kernels: kernel k reads "chain_k" and writes "chain_{k+1}",
+ * each with task_count empty tasks over f32[elements].
+ */
+typedef struct {
+    sf_program**         programs;
+    const char**         names;
+    sf_pipeline_desc     pipe;
+    u32                  kernel_count;
+} sf_bench_chain;
+
+static void _init_symbol(sf_bin_symbol* sym, const char* name, u32 reg, u8 flags) {
+    memset(sym, 0, sizeof(sf_bin_symbol));
+    strncpy(sym->name, name, sizeof(sym->name) - 1);
+    sym->name_hash = sf_fnv1a_hash(name);
+    sym->register_idx = reg;
+    sym->flags = flags;
+}
+
+static sf_program* _make_program(u32 index, u32 task_count, i32 elements) {
+    sf_program* prog = calloc(1, sizeof(sf_program));
+    if (!prog) return NULL;
+    prog->meta.tensor_count = 2;
+    prog->meta.symbol_count = 2;
+    prog->meta.task_count = task_count;
+    prog->tensor_infos = calloc(2, sizeof(sf_type_info));
+    prog->tensor_data = calloc(2, sizeof(void*));
+    prog->tensor_flags = calloc(2, sizeof(u8));
+    prog->symbols = calloc(2, sizeof(sf_bin_symbol));
+    prog->tasks = calloc(task_count ? task_count : 1, sizeof(sf_task));
+
+    for (int r = 0; r < 2; ++r) sf_type_info_init_contiguous(&prog->tensor_infos[r], SF_DTYPE_F32, &elements, 1);
+
+    char name[32];
+    snprintf(name, sizeof(name), "chain_%u", index);
+    _init_symbol(&prog->symbols[0], name, 0, SF_SYMBOL_FLAG_INPUT);
+    snprintf(name, sizeof(name), "chain_%u", index + 1);
+    _init_symbol(&prog->symbols[1], name, 1, SF_SYMBOL_FLAG_OUTPUT);
+    return prog;
+}
+
+static void _free_program(sf_program* prog) {
+    if (!prog) return;
+    free(prog->tensor_infos);
+    free(prog->tensor_data);
+    free(prog->tensor_flags);
+    free(prog->symbols);
+    free(prog->tasks);
+    free(prog);
+}
+
+static bool _make_chain(sf_bench_chain* chain, u32 kernel_count, u32 task_count, i32 elements) {
+    memset(chain, 0, sizeof(sf_bench_chain));
+    chain->kernel_count = kernel_count;
+    chain->programs = calloc(kernel_count, sizeof(sf_program*));
+    chain->names = calloc(kernel_count, sizeof(const char*));
+    chain->pipe.kernels = calloc(kernel_count, sizeof(sf_pipeline_kernel));
+    chain->pipe.resources = calloc(kernel_count + 1, sizeof(sf_pipeline_resource));
+    if (!chain->programs || !chain->names || !chain->pipe.kernels || !chain->pipe.resources) return false;
+
+    for (u32 r = 0; r <= kernel_count; ++r) {
+        char* name = malloc(32);
+        if (!name) return false;
+        snprintf(name, 32, "chain_%u", r);
+        sf_pipeline_resource* res = &chain->pipe.resources[r];
+        res->name = name;
+        res->dtype = SF_DTYPE_F32;
+        res->shape[0] = elements;
+        res->ndim = 1;
+    }
+    chain->pipe.resource_count = kernel_count + 1;
+
+    for (u32 k = 0; k < kernel_count; ++k) {
+        chain->programs[k] = _make_program(k, task_count, elements);
+        if (!chain->programs[k]) return false;
+        char* id = malloc(32);
+        if (!id) return false;
+        snprintf(id, 32, "kernel_%u", k);
+        chain->names[k] = id;
+        chain->pipe.kernels[k].id = id;
+        chain->pipe.kernels[k].frequency = 1;
+    }
+    chain->pipe.kernel_count = kernel_count;
+    return true;
+}
+
+static void _free_chain(sf_bench_chain* chain) {
+    for (u32 k = 0; k < chain->kernel_count; ++k) {
+        if (chain->programs) _free_program(chain->programs[k]);
+        if (chain->names) free((void*)chain->names[k]);
+    }
+    if (chain->pipe.resources) {
+        for (u32 r = 0; r < chain->pipe.resource_count; ++r) free((void*)chain->pipe.resources[r].name);
+    }
+    free(chain->programs);
+    free(chain->names);
+    free(chain->pipe.kernels);
+    free(chain->pipe.resources);
+    memset(chain, 0, sizeof(sf_bench_chain));
+}
+
+// --- Engine Benchmarks ---
+
+typedef struct {
+    sf_engine*      engine;
+    sf_bench_chain* chain;
+} sf_engine_bench;
+
+static void _bench_dispatch(void* user_data, u64 iterations) {
+    sf_engine_bench* b = (sf_engine_bench*)user_data;
+    for (u64 i = 0; i < iterations; ++i) sf_engine_dispatch(b->engine);
+}
+
+static void _bench_bind_pipeline(void* user_data, u64 iterations) {
+    sf_engine_bench* b = (sf_engine_bench*)user_data;
+    for (u64 i = 0; i < iterations; ++i) {
+        sf_engine_reset(b->engine);
+        sf_engine_bind_pipeline(b->engine, &b->chain->pipe, b->chain->programs);
+    }
+}
+
+static void _bench_bind_cartridge(void* user_data, u64 iterations) {
+    sf_engine_bench* b = (sf_engine_bench*)user_data;
+    for (u64 i = 0; i < iterations; ++i) {
+        sf_engine_reset(b->engine);
+        sf_engine_bind_cartridge(b->engine, b->chain->programs, b->chain->names, b->chain->kernel_count);
+    }
+}
+
+static void _bench_sync(void* user_data, u64 iterations) {
+    sf_engine_bench* b = (sf_engine_bench*)user_data;
+    for (u64 i = 0; i < iterations; ++i) sf_engine_sync_resource(b->engine, "chain_0");
+}
+
+typedef struct {
+    sf_engine* engine;
+} sf_resize_bench;
+
+static void _bench_resize(void* user_data, u64 iterations) {
+    sf_resize_bench* b = (sf_resize_bench*)user_data;
+    static const int32_t sizes[4][2] = { { 1280, 720 }, { 1300, 740 }, { 1920, 1080 }, { 640, 360 } };
+    for (u64 i = 0; i < iterations; ++i) {
+        sf_engine_resize_screen(b->engine, sizes[i & 3][0], sizes[i & 3][1]);
+    }
+}
+
+static void _engine_benchmarks(sf_bench_ctx* ctx) {
+    static const struct { const char* name; u32 kernels; u32 tasks; u32 batch; u64 iterations; } dispatch_cases[] = {
+        { "dispatch_k1_t1",        1,  1,  1, 200000 },
+        { "dispatch_k16_t4",      16,  4,  1,  50000 },
+        { "dispatch_k64_t16",     64, 16,  1,  10000 },
+        { "dispatch_k16_t4_b64",  16,  4, 64,   1000 },
+    };
+
+    for (u32 c = 0; c < sizeof(dispatch_cases) / sizeof(dispatch_cases[0]); ++c) {
+        sf_bench_chain chain = {0};
+        sf_engine* engine = _create_batched_engine(dispatch_cases[c].batch);
+        if (!engine || !_make_chain(&chain, dispatch_cases[c].kernels, dispatch_cases[c].tasks, 1024)) {
+            fprintf(stderr, "sf_bench: setup failed for %s\n", dispatch_cases[c].name);
+            _free_chain(&chain);
+            sf_engine_destroy(engine);
+            continue;
+        }
+        sf_engine_bind_pipeline(engine, &chain.pipe, chain.programs);
+        sf_engine_bench b = { engine, &chain };
+        _run(ctx, dispatch_cases[c].name, dispatch_cases[c].iterations, _bench_dispatch, &b);
+        sf_engine_destroy(engine);
+        _free_chain(&chain);
+    }
+
+    // Setup paths
+    {
+        sf_bench_chain chain = {0};
+        sf_engine* engine = _create_engine();
+        if (engine && _make_chain(&chain, 32, 4, 4096)) {
+            sf_engine_bench b = { engine, &chain };
+            _run(ctx, "bind_pipeline_k32", 2000, _bench_bind_pipeline, &b);
+            _run(ctx, "bind_cartridge_k32", 2000, _bench_bind_cartridge, &b);
+
+            sf_engine_reset(engine);
+            sf_engine_bind_pipeline(engine, &chain.pipe, chain.programs);
+            _run(ctx, "sync_16k", 200000, _bench_sync, &b);
+        }
+        sf_engine_destroy(engine);
+        _free_chain(&chain);
+    }
+
+    // Screen resize
+    {
+        sf_bench_chain chain = {0};
+        sf_engine* engine = _create_engine();
+        if (engine && _make_chain(&chain, 4, 1, 16)) {
+            for (u32 r = 0; r < chain.pipe.resource_count; ++r) {
+                sf_pipeline_resource* res = &chain.pipe.resources[r];
+                res->flags |= SF_RESOURCE_FLAG_SCREEN_SIZE;
+                res->shape[0] = 720; res->shape[1] = 1280; res->shape[2] = 4;
+                res->ndim = 3;
+            }
+            sf_engine_bind_pipeline(engine, &chain.pipe, chain.programs);
+            sf_resize_bench b = { engine };
+            _run(ctx, "resize_screen", 2000, _bench_resize, &b);
+        }
+        sf_engine_destroy(engine);
+        _free_chain(&chain);
+    }
+}
+
+// --- Cartridge & Asset Benchmarks ---
+
+static bool _write_cartridge(const char* path, u32 section_count, size_t section_size) {
+    sf_cartridge_header head;
+    memset(&head, 0, sizeof(head));
+    u32 max_sections = (u32)(sizeof(head.sections) / sizeof(head.sections[0]));
+    if (section_count > max_sections) section_count = max_sections;
+
+    head.magic = SF_BINARY_MAGIC;
+    head.section_count = section_count;
+    for (u32 s = 0; s < section_count; ++s) {
+        snprintf(head.sections[s].name, sizeof(head.sections[s].name), "section_%u", s);
+        head.sections[s].type = SF_SECTION_IMAGE;
+        head.sections[s].offset = (u32)(sizeof(head) + s * section_size);
+        head.sections[s].size = (u32)section_size;
+    }
+
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    bool ok = fwrite(&head, sizeof(head), 1, f) == 1;
+    u8* payload = malloc(section_size);
+    if (!payload) { fclose(f); return false; }
+    for (size_t i = 0; i < section_size; ++i) payload[i] = (u8)(i * 131u);
+    for (u32 s = 0; ok && s < section_count; ++s) ok = fwrite(payload, 1, section_size, f) == section_size;
+    free(payload);
+    return (fclose(f) == 0) && ok;
+}
+
+static void _bench_cartridge_open(void* user_data, u64 iterations) {
+    (void)user_data;
+    char name[32];
+    for (u64 i = 0; i < iterations; ++i) {
+        sf_cartridge* cart = sf_cartridge_open(SF_BENCH_TMP_CART);
+        if (!cart) return;
+        for (u32 s = 0; s < cart->header.section_count; ++s) {
+            snprintf(name, sizeof(name), "section_%u", s);
+            size_t size = 0;
+            if (!sf_cartridge_get_section(cart, name, SF_SECTION_IMAGE, &size)) break;
+        }
+        sf_cartridge_close(cart);
+    }
+}
+
+static bool _write_bmp(const char* path, int w, int h) {
+    int row = (w * 3 + 3) & ~3;
+    u32 data_size = (u32)(row * h);
+    u8 hdr[54] = { 'B', 'M' };
+    u32 file_size = 54 + data_size;
+    memcpy(&hdr[2], &file_size, 4);
+    hdr[10] = 54; hdr[14] = 40;
+    memcpy(&hdr[18], &w, 4);
+    memcpy(&hdr[22], &h, 4);
+    hdr[26] = 1; hdr[28] = 24;
+    memcpy(&hdr[34], &data_size, 4);
+
+    FILE* f = fopen(path, "wb");
+    if (!f) return false;
+    bool ok = fwrite(hdr, 1, sizeof(hdr), f) == sizeof(hdr);
+    u8* line = calloc(1, (size_t)row);
+    if (!line) { fclose(f); return false; }
+    for (int y = 0; ok && y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            line[x * 3 + 0] = (u8)x; line[x * 3 + 1] = (u8)y; line[x * 3 + 2] = (u8)(x ^ y);
+        }
+        ok = fwrite(line, 1, (size_t)row, f) == (size_t)row;
+    }
+    free(line);
+    return (fclose(f) == 0) && ok;
+}
+
+static void _bench_image_decode(void* user_data, u64 iterations) {
+    sf_engine* engine = (sf_engine*)user_data;
+    for (u64 i = 0; i < iterations; ++i) {
+        if (!sf_loader_load_image(engine, "chain_0", SF_BENCH_TMP_IMAGE)) return;
+    }
+}
+
+typedef struct {
+    const void* blob;
+    size_t      size;
+    sf_arena    arena;
+} sf_pipeline_bench;
+
+static void _bench_pipeline_decode(void* user_data, u64 iterations) {
+    sf_pipeline_bench* b = (sf_pipeline_bench*)user_data;
+    for (u64 i = 0; i < iterations; ++i) {
+        sf_pipeline_desc desc;
+        sf_arena_reset(&b->arena);
+        if (!sf_pipeline_bin_decode(b->blob, b->size, SF_BENCH_TMP_CART, &b->arena, &desc)) return;
+    }
+}
+
+typedef struct {
+    const void* packed;
+    size_t      packed_size;
+    void*       raw;
+    size_t      raw_size;
+} sf_codec_bench;
+
+static void _bench_codec_decode(void* user_data, u64 iterations) {
+    sf_codec_bench* b = (sf_codec_bench*)user_data;
+    for (u64 i = 0; i < iterations; ++i) {
+        if (!sf_codec_decode(b->packed, b->packed_size, b->raw, b->raw_size, 0)) return;
+    }
+}
+
+static void _io_benchmarks(sf_bench_ctx* ctx) {
+    if (_write_cartridge(SF_BENCH_TMP_CART, 16, SF_KB(64))) {
+        _run(ctx, "cartridge_open_16x64k", 500, _bench_cartridge_open, NULL);
+    } else {
+        fprintf(stderr, "sf_bench: cannot write %s\n", SF_BENCH_TMP_CART);
+    }
+    remove(SF_BENCH_TMP_CART);
+
+    // Section codec: 16 MB of f32 ramps (compressible like typical baked tables)
+    {
+        sf_codec_bench b = { NULL, 0, NULL, SF_MB(16) };
+        f32* src = malloc(b.raw_size);
+        b.raw = malloc(b.raw_size);
+        if (src && b.raw) {
+            for (size_t i = 0; i < b.raw_size / sizeof(f32); ++i) src[i] = (f32)(i % 4096) * 0.25f;
+            b.packed = sf_codec_encode(src, b.raw_size, 0, &b.packed_size);
+            if (b.packed) _run(ctx, "section_decode_16m", 20, _bench_codec_decode, &b);
+        }
+        free((void*)b.packed);
+        free(b.raw);
+        free(src);
+    }
+
+    // Binary pipeline descriptor: no parsing, one pass over fixed records
+    {
+        sf_bench_chain pipe_chain = {0};
+        sf_pipeline_bench b = {0};
+        void* backing = NULL;
+        if (_make_chain(&pipe_chain, 4096, 1, 16)) {
+            b.blob = sf_pipeline_bin_encode(&pipe_chain.pipe, &b.size);
+            size_t arena_size = b.blob ? sf_pipeline_bin_arena_size(b.blob, b.size) : 0;
+            backing = arena_size ? malloc(arena_size) : NULL;
+            if (backing) {
+                sf_arena_init(&b.arena, backing, arena_size);
+                _run(ctx, "pipeline_bin_decode_k4096", 200, _bench_pipeline_decode, &b);
+            }
+        }
+        free(backing);
+        free((void*)b.blob);
+        _free_chain(&pipe_chain);
+    }
+
+    sf_bench_chain chain = {0};
+    sf_engine* engine = _create_engine();
+    if (engine && _write_bmp(SF_BENCH_TMP_IMAGE, 512, 512) && _make_chain(&chain, 1, 1, 16)) {
+        sf_pipeline_resource* res = &chain.pipe.resources[0];
+        res->shape[0] = 512; res->shape[1] = 512; res->shape[2] = 4;
+        res->ndim = 3;
+        sf_engine_bind_pipeline(engine, &chain.pipe, chain.programs);
+        _run(ctx, "image_decode_512", 50, _bench_image_decode, engine);
+        _free_chain(&chain);
+    }
+    sf_engine_destroy(engine);
+    remove(SF_BENCH_TMP_IMAGE);
+}
+
+// --- Reporting ---
+
+static bool _write_json(const sf_bench_ctx* ctx, const char* path) {
+    FILE* f = path ? fopen(path, "w") : stdout;
+    if (!f) {
+        fprintf(stderr, "sf_bench: cannot write '%s'\n", path);
+        return false;
+    }
+    fprintf(f, "{\n  \"benchmarks\": [\n");
+    for (u32 i = 0; i < ctx->result_count; ++i) {
+        const sf_bench_result* r = &ctx->results[i];
+        fprintf(f, "    { \"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.3f, \"total_ms\": %.3f }%s\n",
+            r->name, (unsigned long long)r->iterations, r->ns_per_op, r->total_ms, (i + 1 < ctx->result_count) ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    return path ? fclose(f) == 0 : true;
+}
+
+static double _threshold_for(const char* name, double fallback, const sf_bench_override* overrides, u32 override_count) {
+    for (u32 i = 0; i < override_count; ++i) {
+        if (strcmp(overrides[i].name, name) == 0) return overrides[i].threshold;
+    }
+    return fallback;
+}
+
+/**
+ * Returns the number of regressions, or -1 if the baseline cannot be read.
+ */
+static int _compare_baseline(const sf_bench_ctx* ctx, const char* path, double threshold, const sf_bench_override* overrides, u32 override_count) {
+    size_t size = 0;
+    char* text = (char*)sf_file_read_bin(path, &size);
+    if (!text) {
+        fprintf(stderr, "sf_bench: cannot read baseline '%s'\n", path);
+        return -1;
+    }
+    char* terminated = realloc(text, size + 1);
+    if (!terminated) { free(text); return -1; }
+    terminated[size] = '\0';
+
+    size_t arena_size = size * 8 + SF_KB(64);
+    void* arena_mem = malloc(arena_size);
+    if (!arena_mem) { free(terminated); return -1; }
+    sf_arena arena;
+    sf_arena_init(&arena, arena_mem, arena_size);
+
+    int regressions = -1;
+    sf_json_value* root = sf_json_parse(terminated, &arena);
+    const sf_json_value* list = root ? sf_json_get_field(root, "benchmarks") : NULL;
+    if (list && list->type == SF_JSON_VAL_ARRAY) {
+        regressions = 0;
+        printf("\n%-28s %12s %12s %9s\n", "benchmark", "baseline", "current", "change");
+        for (u32 i = 0; i < ctx->result_count; ++i) {
+            const sf_bench_result* r = &ctx->results[i];
+            const sf_json_value* base = NULL;
+            for (u32 j = 0; j < list->as.array.count; ++j) {
+                const sf_json_value* name = sf_json_get_field(&list->as.array.items[j], "name");
+                if (name && name->type == SF_JSON_VAL_STRING && strcmp(name->as.s, r->name) == 0) {
+                    base = sf_json_get_field(&list->as.array.items[j], "ns_per_op");
+                    break;
+                }
+            }
+            if (!base || base->type != SF_JSON_VAL_NUMBER || base->as.n <= 0.0) {
+                printf("%-28s %12s %12.1f %9s\n", r->name, "-", r->ns_per_op, "new");
+                continue;
+            }
+            double change = (r->ns_per_op - base->as.n) / base->as.n;
+            double limit = _threshold_for(r->name, threshold, overrides, override_count);
+            bool regressed = change > limit;
+            if (regressed) regressions++;
+            printf("%-28s %12.1f %12.1f %+8.1f%%%s\n", r->name, base->as.n, r->ns_per_op, change * 100.0, regressed ? "  REGRESSION" : "");
+        }
+    } else {
+        fprintf(stderr, "sf_bench: '%s' is not a benchmark result file\n", path);
+    }
+
+    free(arena_mem);
+    free(terminated);
+    return regressions;
+}
+
+int main(int argc, char** argv) {
+    const char* out_path = NULL;
+    const char* baseline_path = NULL;
+    double threshold = 0.10;
+    sf_bench_override overrides[SF_BENCH_MAX_OVERRIDES];
+    u32 override_count = 0;
+
+    sf_bench_ctx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) out_path = argv[++i];
+        else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) baseline_path = argv[++i];
+        else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) threshold = atof(argv[++i]);
+        else if (strcmp(argv[i], "--threshold-for") == 0 && i + 1 < argc) {
+            char* spec = argv[++i];
+            char* eq = strchr(spec, '=');
+            if (eq && override_count < SF_BENCH_MAX_OVERRIDES) {
+                *eq = '\0';
+                overrides[override_count].name = spec;
+                overrides[override_count].threshold = atof(eq + 1);
+                override_count++;
+            }
+        }
+        else if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) ctx.filter = argv[++i];
+        else if (strcmp(argv[i], "--quick") == 0) ctx.quick = true;
+        else {
+            fprintf(stderr, "usage: %s [--out file] [--baseline file] [--threshold frac] [--threshold-for name=frac] [--filter substr] [--quick]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    sf_log_set_global_level(SF_LOG_LEVEL_WARN);
+
+    _engine_benchmarks(&ctx);
+    _io_benchmarks(&ctx);
+
+    if (out_path && !_write_json(&ctx, out_path)) return 1;
+    if (!out_path && !baseline_path) _write_json(&ctx, NULL);
+
+    if (baseline_path) {
+        int regressions = _compare_baseline(&ctx, baseline_path, threshold, overrides, override_count);
+        if (regressions < 0) return 1;
+        if (regressions > 0) {
+            printf("\n%d benchmark(s) regressed beyond threshold.\n", regressions);
+            return 2;
+        }
+        printf("\nNo regressions.\n");
+    }
+    return 0;
+}
@@ -13,13 +13,47 @@ typedef struct sf_arena sf_arena;
 // Opaque Engine Handle
 typedef struct sf_engine sf_engine;
 
+/**
+ * @brief Optional hooks for persisting backend bake results.
+ * When both callbacks are set, baked kernels are cached by program content hash
+ * and backend identity, surviving engine resets (and process restarts if a cache dir is given).
+ */
+typedef struct sf_bake_codec {
+    const char* backend_id; // Identity of the backend build (part of the cache key)
+    void* (*serialize)(void* backend_state, const void* baked, size_t* out_size); // Returns malloc'd blob
+    void* (*deserialize)(void* backend_state, const sf_program* prog, const void* data, size_t size);
+} sf_bake_codec;
+
+/**
+ * @brief Page backing for large resource buffers.
+ */
+typedef enum {
+    SF_PAGES_DEFAULT = 0,   // Regular pages from the engine heap
+    SF_PAGES_TRANSPARENT,   // Dedicated mapping with transparent huge page advice
+    SF_PAGES_EXPLICIT       // Explicit huge pages (hugetlbfs pool), falls back to transparent
+} sf_engine_page_mode;
+
 /**
  * @brief Configuration for initializing the engine.
  */
 typedef struct sf_engine_desc {
-    size_t arena_size;      // Static arena for Code/Metadata (default: 8MB)
-    size_t heap_size;       // Dynamic heap for Tensors (default: 64MB)
+    size_t arena_size;      // Arena limit for Code/Metadata (default: 8MB). Reserved, committed on demand.
+    size_t heap_size;       // Heap limit for Tensors (default: 64MB). Reserved, committed on demand.
+    bool release_on_reset;  // Return arena/heap pages to the OS on sf_engine_reset
     sf_backend backend;     // Backend implementation
+    sf_bake_codec bake_codec;       // Optional bake serialization (see sf_bake_codec)
+    const char* bake_cache_dir;     // Optional on-disk bake cache (NULL = memory only)
+    uint32_t setup_threads;         // Parallel kernel baking on bind (0/1 = serial). Backend bake must be thread-safe.
+    sf_engine_page_mode large_pages;    // Backing for buffers >= large_buffer_threshold
+    size_t large_buffer_threshold;      // Default: 2MB
+    uint64_t numa_nodes;                // Bitmask of NUMA nodes for engine memory (0 = OS default)
+
+    // Batched mode: every resource holds batch_size independent instances, stacked along a
+    // leading dimension (instance i at i * per-instance bytes). One sf_engine_dispatch runs all
+    // of them. Kernels marked SF_PIPELINE_KERNEL_ELEMENTWISE that bind only screen-size resources
+    // reach the backend once as [batch * H, W, ...]; every other kernel is dispatched once per
+    // instance, sharing its program and bake, because non-screen shapes are fixed at compile time.
+    uint32_t batch_size;                // 0/1 = single instance
 } sf_engine_desc;
 
 /**
@@ -47,12 +81,75 @@ static inline const char* sf_engine_error_to_str(sf_engine_error err) {
 // --- Lifecycle ---
 
 sf_engine*      sf_engine_create(const sf_engine_desc* desc);
+
+/**
+ * @brief Releases the caller's handle. An engine that still has live clones is freed
+ * when the last clone is destroyed.
+ */
 void            sf_engine_destroy(sf_engine* engine);
+
+/**
+ * @brief Unbinds the pipeline and frees all resources. Refused while clones exist.
+ */
 void            sf_engine_reset(sf_engine* engine);
+
+/**
+ * @brief Arena holding programs and pipeline metadata (cleared by reset).
+ */
 sf_arena*       sf_engine_get_arena(sf_engine* engine);
 
+/**
+ * @brief Creates an engine running the same pipeline from the source's current state.
+ * Programs and bake results are shared with the source. Resource contents are
+ * captured once per source state and shared copy-on-write: a clone gets a private
+ * buffer the first time a kernel writes it, or the host maps or syncs it. Resources
+ * nothing writes (assets, lookup tables) stay shared by all clones.
+ * The source can't be reset, rebound or reloaded while clones exist, and clones
+ * can't be reloaded. Clones share the source's backend (and its state), so engines
+ * may only be dispatched concurrently if the backend's dispatch is reentrant.
+ * Returns NULL if nothing is bound or on failure.
+ */
+sf_engine*      sf_engine_clone(sf_engine* source);
+
+/**
+ * @brief Returns the bound pipeline to its post-setup state for a new session.
+ * With a rewind point, every resource (file mappings aside) gets the contents it had
+ * there. Without one, resources written by kernels get their initial data again (zeros
+ * if none) and resources only the host writes keep their contents. Buffers and frame
+ * index restart. Programs, bake results and allocations are kept, so this costs a
+ * memcpy per resource instead of a reset and rebind.
+ */
+void            sf_engine_rewind(sf_engine* engine);
+
+/**
+ * @brief Saves the current resource contents as the state sf_engine_rewind returns to.
+ * Call once the host has applied its setup (assets, default inputs). Clones created
+ * afterwards share it. Dropped by reset and hot reload; a resource resized since
+ * falls back to its initial data.
+ */
+void            sf_engine_set_rewind_point(sf_engine* engine);
+
 // --- Setup ---
 
+/**
+ * @brief 64-bit FNV-1a hash over raw bytes (used for program content keys).
+ */
+uint64_t        sf_engine_hash_bytes(const void* data, size_t size);
+
+/**
+ * @brief Associates a content hash with a loaded program.
+ * Kernels bound from registered programs can reuse cached bake results.
+ * Registrations are cleared by sf_engine_reset.
+ */
+void            sf_engine_register_program(sf_engine* engine, const sf_program* prog, uint64_t content_hash);
+
+/**
+ * @brief Registers a program that lives in its own malloc'd block and hands the block to the
+ * engine. It is freed once a hot reload leaves the program unbound, or by sf_engine_reset.
+ * Returns false (block still owned by the caller) on failure.
+ */
+bool            sf_engine_adopt_program(sf_engine* engine, const sf_program* prog, uint64_t content_hash, void* block);
+
 /**
  * @brief Binds a pipeline and allocates resources.
  */
@@ -63,6 +160,26 @@ void            sf_engine_bind_pipeline(sf_engine* engine, const sf_pipeline_des
  */
 void            sf_engine_bind_cartridge(sf_engine* engine, sf_program** programs, const char** names, uint32_t program_count);
 
+/**
+ * @brief Re-binds a pipeline in place, diffing it against the running one.
+ * Kernels with the same id and program content keep their state and bake; resources with the
+ * same name and declared dtype/shape keep their buffers (and contents). Only changes are rebuilt.
+ * On failure the previous pipeline stays bound and false is returned.
+ */
+bool            sf_engine_reload_pipeline(sf_engine* engine, const sf_pipeline_desc* pipe, sf_program** programs);
+
+/**
+ * @brief Returns true if the last sf_engine_reload_pipeline carried the named resource's
+ * buffers (and contents) over. Fresh resources need their host data (assets) applied again.
+ */
+bool            sf_engine_is_resource_kept(sf_engine* engine, const char* name);
+
+/**
+ * @brief Returns a bound program with the given content hash (NULL if none).
+ * Lets loaders skip re-loading unchanged programs on hot reload.
+ */
+sf_program*     sf_engine_find_program(sf_engine* engine, uint64_t content_hash);
+
 // --- Execution ---
 
 /**
@@ -70,6 +187,18 @@ void            sf_engine_bind_cartridge(sf_engine* engine, sf_program** program
  */
 void            sf_engine_dispatch(sf_engine* engine);
 
+#define SF_ENGINE_ROI_ROWS 16 // Row granularity of dirty-row dispatch
+
+/**
+ * @brief Limits the next dispatch to the rows [y, y + h) of the screen-size resources.
+ * Kernels marked ROI_SAFE or ELEMENTWISE (SF_PIPELINE_KERNEL_*) that write screen-size outputs see every
+ * screen-size binding as the full-width band (aligned to SF_ENGINE_ROI_ROWS), handed to the
+ * backend as one smaller domain; rows outside it are carried over from the previous frame.
+ * Other kernels run over the full frame. A "u_TileOffset" resource receives [0, band start].
+ * Pass h <= 0 to clear. Returns false (full frame) in batched mode or if no kernel is ROI-safe.
+ */
+bool            sf_engine_set_dirty_rows(sf_engine* engine, int32_t y, int32_t h);
+
 // --- State & Resource Access ---
 
 /**
@@ -77,11 +206,50 @@ void            sf_engine_dispatch(sf_engine* engine);
  */
 sf_tensor*      sf_engine_map_resource(sf_engine* engine, const char* name);
 
+/**
+ * @brief Number of instances per resource (1 unless created with batch_size).
+ */
+uint32_t        sf_engine_get_batch_size(sf_engine* engine);
+
+/**
+ * @brief Fills out_view with one instance of a batched resource (front buffer).
+ * The view has the per-instance shape and addresses the instance through byte_offset.
+ * Write through it, then sf_engine_sync_resource as with sf_engine_map_resource.
+ * sf_engine_map_resource itself addresses instance 0.
+ */
+bool            sf_engine_map_instance(sf_engine* engine, const char* name, uint32_t instance, sf_tensor* out_view);
+
+/**
+ * @brief Copies instance 0 of a resource (front buffer) over every other instance.
+ * Call after writing shared data through sf_engine_map_resource, before
+ * sf_engine_sync_resource. Always succeeds for an existing resource without batching.
+ */
+bool            sf_engine_broadcast_instance(sf_engine* engine, const char* name);
+
+/**
+ * @brief Returns true if any bound kernel reads the named global resource.
+ */
+bool            sf_engine_is_resource_read(sf_engine* engine, const char* name);
+
+/**
+ * @brief Returns true if no kernel reads a value written by a kernel in an earlier frame.
+ * Frames of such a pipeline depend only on host inputs and can be rendered in any order
+ * (or on several engines). Persistent resources written by a kernel count as carried state.
+ */
+bool            sf_engine_is_frame_independent(sf_engine* engine);
+
 /**
  * @brief Force resize a global resource.
  */
 bool            sf_engine_resize_resource(sf_engine* engine, const char* name, const int32_t* new_shape, uint8_t new_ndim);
 
+/**
+ * @brief Resizes all SF_RESOURCE_FLAG_SCREEN_SIZE resources to [height, width, ...] in one transaction.
+ * Growth is allocated with headroom so interactive resizing does not reallocate every step.
+ * If any resource cannot be resized the engine enters the OOM error state and false is returned.
+ */
+bool            sf_engine_resize_screen(sf_engine* engine, int32_t width, int32_t height);
+
 /**
  * @brief Synchronizes front and back buffers for a resource (for static data loading).
  */
@@ -92,6 +260,128 @@ void            sf_engine_sync_resource(sf_engine* engine, const char* name);
  */
 sf_engine_error sf_engine_get_error(sf_engine* engine);
 
+// --- Memory Accounting ---
+
+/**
+ * @brief Engine memory usage. Peaks persist across sf_engine_reset.
+ */
+typedef struct {
+    size_t arena_limit;
+    size_t arena_used;
+    size_t arena_peak;
+
+    size_t heap_limit;
+    size_t heap_used;          // Live bytes allocated by the engine
+    size_t heap_cached;        // Freed blocks kept by the size-class pool for reuse
+    size_t heap_peak;
+    size_t heap_largest_free;  // Largest block still allocatable
+    float  heap_fragmentation; // 1 - largest_free / free (0 = unfragmented)
+    uint32_t allocation_count;
+
+    size_t resource_bytes;     // All resource buffers (front + back)
+    size_t register_bytes;     // Kernel-owned registers
+    size_t baked_bytes;        // Serialized bake sizes (when a bake codec is set)
+} sf_engine_memory_stats;
+
+/**
+ * @brief Per-resource or per-kernel memory usage.
+ */
+typedef struct {
+    const char* name;
+    bool     is_kernel;
+    size_t   bytes;        // Resource: both buffers. Kernel: owned registers.
+    size_t   baked_bytes;  // Kernel only (0 if unknown)
+    uint8_t  buffer_count; // Resource only (1 = transient, 2 = double buffered)
+} sf_engine_memory_entry;
+
+typedef void (*sf_engine_memory_cb)(const sf_engine_memory_entry* entry, void* user_data);
+
+/**
+ * @brief Fills memory statistics. Probes the heap for fragmentation; not meant for per-frame use.
+ */
+bool            sf_engine_get_memory_stats(sf_engine* engine, sf_engine_memory_stats* out);
+
+/**
+ * @brief Iterates over per-resource and per-kernel memory usage.
+ */
+void            sf_engine_iterate_memory(sf_engine* engine, sf_engine_memory_cb cb, void* user_data);
+
+/**
+ * @brief Returns blocks cached by the engine's size-class pool to the heap (compaction).
+ * sf_engine_reset always starts from an empty heap.
+ */
+void            sf_engine_trim(sf_engine* engine);
+
+// --- Profiling ---
+
+/**
+ * @brief Accumulated cost of a kernel (task_index < 0) or of one of its tasks.
+ * Hardware counters are summed over the dispatching thread and backend worker threads; the
+ * process main thread (unless it dispatches) and sf_thread helpers are not counted.
+ */
+typedef struct {
+    const char* kernel_id;
+    int32_t  task_index;      // -1 = whole kernel
+    uint64_t invocations;
+    uint64_t time_ns;
+    bool     counters_valid;  // false when perf events are unavailable
+    uint64_t cycles;
+    uint64_t instructions;
+    uint64_t llc_misses;
+    uint64_t branch_misses;
+} sf_engine_kernel_counters;
+
+typedef void (*sf_engine_counters_cb)(const sf_engine_kernel_counters* entry, void* user_data);
+
+/**
+ * @brief Starts profiling every kernel (and every task if per_task) in sf_engine_dispatch.
+ * Opens cycles/instructions/LLC-miss/branch-miss counter groups for the calling thread and the
+ * backend worker threads alive now. Each sample reads one group per counted thread, so with
+ * per_task a task is bracketed by 2 * (workers + 1) syscalls; keep tasks coarse when profiling.
+ * Returns false if hardware counters are not available (wall time is still collected).
+ */
+bool            sf_engine_enable_profiling(sf_engine* engine, bool per_task);
+
+/**
+ * @brief Stops profiling and releases counters and accumulated data.
+ */
+void            sf_engine_disable_profiling(sf_engine* engine);
+
+/**
+ * @brief Zeroes accumulated counters and re-scans threads (e.g. after backend workers started).
+ */
+void            sf_engine_reset_profiling(sf_engine* engine);
+
+/**
+ * @brief Iterates accumulated counters: per kernel, followed by its tasks when per-task profiling is on.
+ */
+void            sf_engine_iterate_counters(sf_engine* engine, sf_engine_counters_cb cb, void* user_data);
+
+// --- Snapshots ---
+
+typedef enum {
+    SF_SNAPSHOT_PERSISTENT = 0, // Only SF_RESOURCE_FLAG_PERSISTENT resources
+    SF_SNAPSHOT_ALL             // Every allocated resource
+} sf_snapshot_scope;
+
+/**
+ * @brief Writes resource contents and frame index to a compact, mappable binary file.
+ * File-mapped resources are not copied: writable ones are flushed to their own files instead.
+ */
+bool            sf_engine_snapshot(sf_engine* engine, const char* path, sf_snapshot_scope scope);
+
+/**
+ * @brief Restores a snapshot into the bound pipeline without recomputation.
+ * Entries are validated (dtype/shape, batch size) against the pipeline before any data is written.
+ */
+bool            sf_engine_restore(sf_engine* engine, const char* path);
+
+/**
+ * @brief Writes the dirty pages of writable file-mapped resources (SF_RESOURCE_MAP_WRITE) back
+ * to their files, making the files a checkpoint of those resources. Returns false on I/O errors.
+ */
+bool            sf_engine_flush_mapped(sf_engine* engine);
+
 /**
  * @brief Callback for resource iteration.
  */
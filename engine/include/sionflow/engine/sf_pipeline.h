@@ -3,6 +3,14 @@
 
 #include <sionflow/base/sf_types.h>
 #include <sionflow/isa/sf_tensor.h>
+#include <sionflow/base/sf_memory.h>
+
+// Out-of-core backing for a resource (sf_pipeline_resource.map_flags)
+typedef enum {
+    SF_RESOURCE_MAP_READ     = 1 << 0, // Map map_path read-only (host writes stay private); the file must hold the whole resource
+    SF_RESOURCE_MAP_WRITE    = 1 << 1, // Map read/write; the file is created or grown, writes land in it
+    SF_RESOURCE_MAP_PREFETCH = 1 << 2  // Start reading it in while the kernel before its reader runs
+} sf_resource_map_flags;
 
 // Description of a Global Resource (Blackboard Buffer)
 typedef struct {
@@ -11,6 +19,8 @@ typedef struct {
     int32_t shape[SF_MAX_DIMS];
     uint8_t ndim;
     uint8_t flags;
+    uint8_t map_flags;      // SF_RESOURCE_MAP_* (0 = engine heap)
+    const char* map_path;   // File backing the resource when map_flags is set
 } sf_pipeline_resource;
 
 // Mapping between a Kernel's internal Symbol and a Global Resource
@@ -19,11 +29,19 @@ typedef struct {
     const char* global_resource; // Resource name defined in sf_pipeline_desc
 } sf_pipeline_binding;
 
+// Kernel reads and writes screen-size resources strictly per pixel (no neighbour reads) and
+// adds u_TileOffset to its pixel coordinates: it may run over a dirty row band only
+#define SF_PIPELINE_KERNEL_ROI_SAFE    (1u << 0)
+// Every output element depends only on the same element of the inputs (no coordinates, no
+// neighbours): in batched mode it may run once over all instances stacked along the rows
+#define SF_PIPELINE_KERNEL_ELEMENTWISE (1u << 1)
+
 // Description of a single execution unit (Shader/Kernel)
 typedef struct {
     const char* id;
     const char* graph_path; // Path to .json or .bin
     uint32_t frequency;     // 1 = every frame, N = N times per frame
+    uint32_t flags;         // SF_PIPELINE_KERNEL_*
     
     sf_pipeline_binding* bindings;
     uint32_t binding_count;
@@ -38,4 +56,30 @@ typedef struct {
     uint32_t kernel_count;
 } sf_pipeline_desc;
 
+// --- Binary Form ---
+
+#define SF_PIPELINE_BIN_MAGIC 0x42504653u // "SFPB", first bytes of a binary pipeline section
+
+/**
+ * @brief True if data holds a binary pipeline descriptor (otherwise it is the JSON form).
+ */
+bool   sf_pipeline_bin_check(const void* data, size_t size);
+
+/**
+ * @brief Arena bytes sf_pipeline_bin_decode needs for this blob (0 if it is malformed).
+ */
+size_t sf_pipeline_bin_arena_size(const void* data, size_t size);
+
+/**
+ * @brief Maps a binary pipeline descriptor onto out without parsing. Records are widened
+ * into the arena and names point into one copy of the blob's string table.
+ * Every kernel gets graph_path (copied once). Fails on malformed or foreign-layout blobs.
+ */
+bool   sf_pipeline_bin_decode(const void* data, size_t size, const char* graph_path, sf_arena* arena, sf_pipeline_desc* out);
+
+/**
+ * @brief Encodes a pipeline into a malloc'd binary blob (free with free()). graph_path is not stored.
+ */
+void*  sf_pipeline_bin_encode(const sf_pipeline_desc* pipe, size_t* out_size);
+
 #endif // SF_PIPELINE_H
@@ -0,0 +1,64 @@
+#ifndef SF_THREAD_H
+#define SF_THREAD_H
+
+#include <sionflow/base/sf_types.h>
+
+/**
+ * Minimal portable threading helpers used by the engine and hosts
+ * (setup fan-out, background workers). Not a job system.
+ */
+
+typedef struct sf_thread sf_thread;
+
+typedef void (*sf_thread_fn)(void* user_data);
+
+/**
+ * @brief Starts a thread running fn(user_data). Returns NULL on failure.
+ */
+sf_thread*  sf_thread_start(sf_thread_fn fn, void* user_data);
+
+/**
+ * @brief Waits for a thread to finish and releases it.
+ */
+void        sf_thread_join(sf_thread* thread);
+
+/**
+ * @brief Number of hardware threads available to the process (at least 1).
+ */
+u32         sf_thread_hw_count(void);
+
+/**
+ * @brief True if os_tid (a Linux thread id) is a running thread started by sf_thread_start.
+ * Lets profiling tell engine/host helper threads from backend workers. Always false elsewhere.
+ */
+bool        sf_thread_is_helper(int64_t os_tid);
+
+// --- Atomics ---
+// Read-modify-write companions to base's sf_atomic_load/sf_atomic_store on sf_atomic_i32.
+
+/**
+ * @brief Adds value and returns the previous contents.
+ */
+int32_t     sf_atomic_i32_fetch_add(sf_atomic_i32* ptr, int32_t value);
+
+/**
+ * @brief Stores value and returns the previous contents.
+ */
+int32_t     sf_atomic_i32_exchange(sf_atomic_i32* ptr, int32_t value);
+
+/**
+ * @brief Stores desired if the contents equal expected. Returns true if it did.
+ */
+bool        sf_atomic_i32_compare_exchange(sf_atomic_i32* ptr, int32_t expected, int32_t desired);
+
+// --- Parallel For ---
+
+typedef void (*sf_parallel_fn)(void* ctx, u32 index);
+
+/**
+ * @brief Runs fn(ctx, i) for i in [0, count) on up to max_threads threads (0 = all cores).
+ * The calling thread participates. Returns when every index has been processed.
+ */
+void        sf_parallel_for(u32 count, u32 max_threads, sf_parallel_fn fn, void* ctx);
+
+#endif // SF_THREAD_H
@@ -0,0 +1,309 @@
+#include <sionflow/engine/sf_engine.h>
+#include <sionflow/engine/sf_thread.h>
+#include "sf_engine_internal.h"
+#include <sionflow/base/sf_log.h>
+#include <sionflow/base/sf_utils.h>
+#include <sionflow/base/sf_platform.h>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SF_BAKE_FILE_MAGIC   0x4B424653u // "SFBK"
+#define SF_BAKE_FILE_VERSION 1u
+
+typedef struct {
+    u32 magic;
+    u32 version;
+    u64 key;
+    u64 size;
+} sf_bake_file_header;
+
+// --- Hashing ---
+
+uint64_t sf_engine_hash_bytes(const void* data, size_t size) {
+    const u8* p = (const u8*)data;
+    u64 h = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size; ++i) {
+        h ^= p[i];
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+static u64 _bake_key(const sf_engine* engine, u64 program_hash) {
+    const char* id = engine->bake_codec.backend_id ? engine->bake_codec.backend_id : "";
+    u64 id_hash = sf_engine_hash_bytes(id, strlen(id));
+    u64 key = program_hash ^ (id_hash + 0x9e3779b97f4a7c15ull + (program_hash << 6) + (program_hash >> 2));
+    return key ? key : 1;
+}
+
+// --- Program Registry ---
+
+static bool _register_program(sf_engine* engine, const sf_program* prog, uint64_t content_hash, void* block) {
+    for (u32 i = 0; i < engine->program_key_count; ++i) {
+        if (engine->program_keys[i].program == prog) {
+            engine->program_keys[i].hash = content_hash;
+            if (block) engine->program_keys[i].block = block;
+            return true;
+        }
+    }
+    if (engine->program_key_count == engine->program_key_cap) {
+        u32 new_cap = engine->program_key_cap ? engine->program_key_cap * 2 : 16;
+        sf_program_key* keys = realloc(engine->program_keys, sizeof(sf_program_key) * new_cap);
+        if (!keys) return false;
+        engine->program_keys = keys;
+        engine->program_key_cap = new_cap;
+    }
+    engine->program_keys[engine->program_key_count].program = prog;
+    engine->program_keys[engine->program_key_count].hash = content_hash;
+    engine->program_keys[engine->program_key_count].block = block;
+    engine->program_key_count++;
+    return true;
+}
+
+void sf_engine_register_program(sf_engine* engine, const sf_program* prog, uint64_t content_hash) {
+    if (!engine || !prog) return;
+    _register_program(engine, prog, content_hash, NULL);
+}
+
+bool sf_engine_adopt_program(sf_engine* engine, const sf_program* prog, uint64_t content_hash, void* block) {
+    if (!engine || !prog || !block) return false;
+    return _register_program(engine, prog, content_hash, block);
+}
+
+void sf_engine_prune_programs(sf_engine* engine) {
+    u32 kept = 0;
+    for (u32 i = 0; i < engine->program_key_count; ++i) {
+        bool bound = false;
+        for (u32 k = 0; k < engine->kernel_count && !bound; ++k) bound = (engine->kernels[k].program == engine->program_keys[i].program);
+        if (bound) engine->program_keys[kept++] = engine->program_keys[i];
+        else free(engine->program_keys[i].block); // Replaced by a reload
+    }
+    engine->program_key_count = kept;
+}
+
+void sf_engine_release_programs(sf_engine* engine) {
+    for (u32 i = 0; i < engine->program_key_count; ++i) free(engine->program_keys[i].block);
+    engine->program_key_count = 0;
+}
+
+u64 sf_engine_program_hash(sf_engine* engine, const sf_program* prog) {
+    if (!engine) return 0;
+    for (u32 i = 0; i < engine->program_key_count; ++i) {
+        if (engine->program_keys[i].program == prog) return engine->program_keys[i].hash;
+    }
+    return 0;
+}
+
+// --- Cache Storage ---
+
+static sf_bake_entry* _find_entry(sf_engine* engine, u64 key) {
+    for (u32 i = 0; i < engine->bake_entry_count; ++i) {
+        if (engine->bake_entries[i].key == key) return &engine->bake_entries[i];
+    }
+    return NULL;
+}
+
+static sf_bake_entry* _insert_entry(sf_engine* engine, u64 key, void* data, size_t size) {
+    if (engine->bake_entry_count == engine->bake_entry_cap) {
+        u32 new_cap = engine->bake_entry_cap ? engine->bake_entry_cap * 2 : 16;
+        sf_bake_entry* entries = realloc(engine->bake_entries, sizeof(sf_bake_entry) * new_cap);
+        if (!entries) return NULL;
+        engine->bake_entries = entries;
+        engine->bake_entry_cap = new_cap;
+    }
+    sf_bake_entry* e = &engine->bake_entries[engine->bake_entry_count++];
+    e->key = key;
+    e->data = data;
+    e->size = size;
+    return e;
+}
+
+static void _remove_entry(sf_engine* engine, sf_bake_entry* e) {
+    free(e->data);
+    *e = engine->bake_entries[--engine->bake_entry_count];
+}
+
+static void _entry_path(const sf_engine* engine, u64 key, char* out, size_t out_size) {
+    snprintf(out, out_size, "%s/%016llx.sfbake", engine->bake_cache_dir, (unsigned long long)key);
+}
+
+static sf_bake_entry* _load_from_disk(sf_engine* engine, u64 key) {
+    char path[1024];
+    _entry_path(engine, key, path, sizeof(path));
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+
+    sf_bake_file_header head;
+    void* data = NULL;
+    if (fread(&head, sizeof(head), 1, f) == 1 &&
+        head.magic == SF_BAKE_FILE_MAGIC && head.version == SF_BAKE_FILE_VERSION &&
+        head.key == key && head.size > 0) {
+        data = malloc((size_t)head.size);
+        if (data && fread(data, 1, (size_t)head.size, f) != (size_t)head.size) {
+            free(data);
+            data = NULL;
+        }
+    }
+    fclose(f);
+
+    if (!data) {
+        SF_LOG_WARN("Engine: Ignoring corrupt bake cache file '%s'.", path);
+        return NULL;
+    }
+    sf_bake_entry* e = _insert_entry(engine, key, data, (size_t)head.size);
+    if (!e) free(data);
+    return e;
+}
+
+bool sf_engine_replace_file(const char* tmp_path, const char* path) {
+#ifdef _WIN32
+    return MoveFileExA(tmp_path, path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return rename(tmp_path, path) == 0; // Atomic over an existing file
+#endif
+}
+
+static void _store_to_disk(sf_engine* engine, const sf_bake_entry* e) {
+    char path[1024], tmp_path[1040];
+    _entry_path(engine, e->key, path, sizeof(path));
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+
+    FILE* f = fopen(tmp_path, "wb");
+    if (!f) {
+        SF_LOG_WARN("Engine: Cannot write bake cache file '%s'.", tmp_path);
+        return;
+    }
+    sf_bake_file_header head = { SF_BAKE_FILE_MAGIC, SF_BAKE_FILE_VERSION, e->key, (u64)e->size };
+    bool ok = fwrite(&head, sizeof(head), 1, f) == 1 && fwrite(e->data, 1, e->size, f) == e->size;
+    ok = (fclose(f) == 0) && ok;
+
+    // Publish atomically so concurrent processes never observe a partial or missing file
+    if (!ok || !sf_engine_replace_file(tmp_path, path)) remove(tmp_path);
+}
+
+// --- Baking ---
+
+/**
+ * Per-kernel bake job. Cache lookups and inserts happen serially on the
+ * binding thread; only deserialize/bake/serialize run on workers.
+ */
+typedef struct {
+    sf_kernel_inst* ker;
+    u64             key;       // 0 = not cacheable
+    const void*     cached;    // Serialized blob found in cache (if any)
+    size_t          cached_size;
+    void*           blob;      // Freshly serialized result (owned until inserted)
+    size_t          blob_size;
+    bool            rejected;  // Cached blob was refused by the backend
+} sf_bake_job;
+
+typedef struct {
+    sf_engine*   engine;
+    sf_bake_job* jobs;
+} sf_bake_batch;
+
+static void _bake_job_run(void* ctx, u32 index) {
+    sf_bake_batch* batch = (sf_bake_batch*)ctx;
+    sf_engine* engine = batch->engine;
+    sf_bake_job* job = &batch->jobs[index];
+    sf_backend* backend = &engine->backend;
+    const sf_bake_codec* codec = &engine->bake_codec;
+    if (!job->ker->program) return;
+
+    if (job->cached) {
+        void* baked = codec->deserialize(backend->state, job->ker->program, job->cached, job->cached_size);
+        if (baked) {
+            job->ker->state.baked_data = baked;
+            job->ker->baked_size = job->cached_size;
+            return;
+        }
+        job->rejected = true;
+    }
+
+    job->ker->state.baked_data = backend->bake(backend->state, job->ker->program);
+    if (job->key && job->ker->state.baked_data) {
+        job->blob = codec->serialize(backend->state, job->ker->state.baked_data, &job->blob_size);
+        job->ker->baked_size = job->blob ? job->blob_size : 0;
+    }
+}
+
+void sf_engine_bake_kernels(sf_engine* engine, const bool* mask) {
+    sf_backend* backend = &engine->backend;
+    u32 job_count = 0;
+    for (u32 k = 0; k < engine->kernel_count; ++k) {
+        if (mask && !mask[k]) continue;
+        engine->kernels[k].state.baked_data = NULL;
+        engine->kernels[k].baked_size = 0;
+        job_count++;
+    }
+    if (!backend->bake || job_count == 0) return;
+
+    sf_bake_job* jobs = calloc(job_count, sizeof(sf_bake_job));
+    if (!jobs) {
+        SF_LOG_ERROR("Engine: Failed to allocate bake jobs.");
+        return;
+    }
+
+    // 1. Resolve cache hits (may pull entries from disk)
+    const sf_bake_codec* codec = &engine->bake_codec;
+    bool can_cache = codec->serialize && codec->deserialize;
+    for (u32 k = 0, j = 0; k < engine->kernel_count; ++k) {
+        if (mask && !mask[k]) continue;
+        sf_bake_job* job = &jobs[j++];
+        job->ker = &engine->kernels[k];
+        if (!can_cache || !job->ker->program || job->ker->program_hash == 0) continue;
+        job->key = _bake_key(engine, job->ker->program_hash);
+
+        sf_bake_entry* e = _find_entry(engine, job->key);
+        if (!e && engine->bake_cache_dir) e = _load_from_disk(engine, job->key);
+        if (e) { job->cached = e->data; job->cached_size = e->size; }
+    }
+
+    // 2. Bake (entries are not mutated while workers read them)
+    sf_bake_batch batch = { engine, jobs };
+    u32 threads = engine->setup_threads ? engine->setup_threads : 1;
+    sf_parallel_for(job_count, threads, _bake_job_run, &batch);
+
+    // 3. Publish new results
+    for (u32 k = 0; k < job_count; ++k) {
+        sf_bake_job* job = &jobs[k];
+        if (job->cached && !job->rejected) {
+            SF_LOG_DEBUG("Engine: Reused cached bake for kernel '%s'.", job->ker->id);
+            continue;
+        }
+        if (job->rejected) {
+            SF_LOG_WARN("Engine: Cached bake for kernel '%s' was rejected by backend. Rebaked.", job->ker->id);
+            sf_bake_entry* stale = _find_entry(engine, job->key);
+            if (stale) _remove_entry(engine, stale);
+        }
+        if (!job->blob) continue;
+        if (job->blob_size == 0 || _find_entry(engine, job->key)) { free(job->blob); continue; }
+
+        sf_bake_entry* e = _insert_entry(engine, job->key, job->blob, job->blob_size);
+        if (!e) { free(job->blob); continue; }
+        if (engine->bake_cache_dir) _store_to_disk(engine, e);
+    }
+
+    free(jobs);
+}
+
+void sf_bake_cache_shutdown(sf_engine* engine) {
+    for (u32 i = 0; i < engine->bake_entry_count; ++i) free(engine->bake_entries[i].data);
+    free(engine->bake_entries);
+    sf_engine_release_programs(engine);
+    free(engine->program_keys);
+    free(engine->bake_cache_dir);
+    free(engine->bake_backend_id);
+    engine->bake_entries = NULL;
+    engine->bake_entry_count = engine->bake_entry_cap = 0;
+    engine->program_keys = NULL;
+    engine->program_key_count = engine->program_key_cap = 0;
+    engine->bake_cache_dir = NULL;
+    engine->bake_backend_id = NULL;
+    engine->bake_codec.backend_id = NULL;
+}
@@ -1,85 +1,118 @@
 #include <sionflow/engine/sf_engine.h>
+#include <sionflow/engine/sf_thread.h>
 #include "sf_engine_internal.h"
+#include "sf_vmem.h"
+#include "sf_perf.h"
 #include <sionflow/base/sf_log.h>
 #include <sionflow/base/sf_shape.h>
 #include <sionflow/base/sf_utils.h>
+#include <sionflow/base/sf_platform.h>
 #include <sionflow/isa/sf_exec_ctx.h>
 #include <string.h>
 #include <stdio.h>
 
 // --- Internal State Management ---
 
-void sf_state_reset(sf_state* state, const sf_program* prog, sf_arena* arena, sf_backend* backend) {
-    if (!prog) return;
-    
+static bool _is_static_register(const sf_program* prog, u32 i) {
+    const sf_type_info* info = &prog->tensor_infos[i];
+    uint8_t flags = prog->tensor_flags[i];
+    if (prog->tensor_data[i] || (flags & SF_TENSOR_FLAG_ALIAS) || (flags & SF_TENSOR_FLAG_GENERATOR)) return false;
+    for (int d = 0; d < info->ndim; ++d) if (info->shape[d] < 0) return false;
+    return true;
+}
+
+static size_t _table_size(u32 register_count) {
+    return (sizeof(void*) + 3 * sizeof(uint8_t) + sizeof(int32_t) * SF_MAX_DIMS) * register_count;
+}
+
+size_t sf_state_table_size(const sf_program* prog) {
+    return prog ? _table_size(prog->meta.tensor_count) : 0;
+}
+
+// Consolidated register tables: pointers + info + ownership flags
+static bool _push_tables(sf_state* state, sf_arena* arena) {
+    size_t ptrs_sz = sizeof(void*) * state->register_count;
+    size_t ndims_sz = sizeof(uint8_t) * state->register_count;
+    size_t dtypes_sz = sizeof(uint8_t) * state->register_count;
+    size_t shapes_sz = sizeof(int32_t) * state->register_count * SF_MAX_DIMS;
+
+    u8* block = SF_ARENA_PUSH(arena, u8, _table_size(state->register_count));
+    if (!block) return false;
+    state->reg_data = (void**)block;
+    state->reg_ndims = (uint8_t*)(block + ptrs_sz);
+    state->reg_dtypes = (uint8_t*)(block + ptrs_sz + ndims_sz);
+    state->reg_shapes = (int32_t*)(block + ptrs_sz + ndims_sz + dtypes_sz);
+    state->ownership_flags = (uint8_t*)(block + ptrs_sz + ndims_sz + dtypes_sz + shapes_sz);
+    return true;
+}
+
+bool sf_state_relocate(sf_state* state, sf_arena* arena) {
+    if (!state->reg_data) return true;
+    sf_state old = *state;
+    if (!_push_tables(state, arena)) {
+        *state = old;
+        return false;
+    }
+    u32 n = state->register_count;
+    memcpy(state->reg_data, old.reg_data, sizeof(void*) * n);
+    memcpy(state->reg_ndims, old.reg_ndims, n);
+    memcpy(state->reg_dtypes, old.reg_dtypes, n);
+    memcpy(state->reg_shapes, old.reg_shapes, sizeof(int32_t) * SF_MAX_DIMS * n);
+    memcpy(state->ownership_flags, old.ownership_flags, n);
+    return true;
+}
+
+bool sf_state_reserve(sf_state* state, const sf_program* prog, sf_arena* arena) {
+    if (!prog) return false;
+
     state->register_count = prog->meta.tensor_count;
-    
-    // Consolidate allocations: pointers + info + ownership flags
-        size_t ptrs_sz = sizeof(void*) * state->register_count;
-        size_t ndims_sz = sizeof(uint8_t) * state->register_count;
-        size_t dtypes_sz = sizeof(uint8_t) * state->register_count;
-        size_t shapes_sz = sizeof(int32_t) * state->register_count * SF_MAX_DIMS;
-        size_t flags_sz = sizeof(uint8_t) * state->register_count;
-    
-        u8* block = SF_ARENA_PUSH(arena, u8, ptrs_sz + ndims_sz + dtypes_sz + shapes_sz + flags_sz);
-        
-        if (!block) {
-            SF_LOG_ERROR("Engine: Failed to allocate kernel state. Arena OOM.");
-            state->register_count = 0;
-            state->reg_data = NULL;
-            state->reg_ndims = NULL;
-            state->reg_dtypes = NULL;
-            state->reg_shapes = NULL;
-            state->ownership_flags = NULL;
-            return;
-        }
-        
-        state->reg_data = (void**)block;
-        state->reg_ndims = (uint8_t*)(block + ptrs_sz);
-        state->reg_dtypes = (uint8_t*)(block + ptrs_sz + ndims_sz);
-        state->reg_shapes = (int32_t*)(block + ptrs_sz + ndims_sz + dtypes_sz);
-        state->ownership_flags = (uint8_t*)(block + ptrs_sz + ndims_sz + dtypes_sz + shapes_sz);
-        
-        memset(state->reg_data, 0, ptrs_sz);
-        memset(state->ownership_flags, 0, flags_sz);
-    
-        for (u32 i = 0; i < state->register_count; ++i) {
-            sf_type_info* info_prog = &prog->tensor_infos[i];
-            void* data_prog = prog->tensor_data[i];
-            uint8_t flags = prog->tensor_flags[i];
-            
-            state->reg_ndims[i] = info_prog->ndim;
-            state->reg_dtypes[i] = (uint8_t)info_prog->dtype;
-            memcpy(&state->reg_shapes[i * SF_MAX_DIMS], info_prog->shape, sizeof(i32) * SF_MAX_DIMS);
-    
-            if (data_prog) {
-            state->reg_data[i] = data_prog;
-            state->ownership_flags[i] = 0; // Constants are not owned by state (owned by program)
-        } else {
-            // Pre-allocate only non-alias, non-generator static tensors
-            if (!(flags & SF_TENSOR_FLAG_ALIAS) && !(flags & SF_TENSOR_FLAG_GENERATOR)) {
-                bool is_static = true;
-                for (int d = 0; d < info_prog->ndim; ++d) if (info_prog->shape[d] < 0) { is_static = false; break; }
-                if (is_static) {
-                    size_t bytes = sf_shape_calc_bytes(info_prog->dtype, info_prog->shape, info_prog->ndim);
-                    if (bytes > 0) {
-                        state->reg_data[i] = state->allocator->alloc(state->allocator, bytes);
-                        if (state->reg_data[i]) {
-                            state->ownership_flags[i] = 1;
-                        }
-                    }
-                }
-            }
-        }
+    if (!_push_tables(state, arena)) {
+        SF_LOG_ERROR("Engine: Failed to allocate kernel state. Arena OOM.");
+        state->register_count = 0;
+        state->reg_data = NULL;
+        state->reg_ndims = NULL;
+        state->reg_dtypes = NULL;
+        state->reg_shapes = NULL;
+        state->ownership_flags = NULL;
+        return false;
     }
+    memset(state->reg_data, 0, sizeof(void*) * state->register_count);
+    memset(state->ownership_flags, 0, state->register_count);
 
-    // --- BAKING PHASE ---
-    if (backend && backend->bake) {
-        state->baked_data = backend->bake(backend->state, prog);
+    // Pre-allocate only non-alias, non-generator static tensors
+    for (u32 i = 0; i < state->register_count; ++i) {
+        if (!_is_static_register(prog, i)) continue;
+        const sf_type_info* info = &prog->tensor_infos[i];
+        size_t bytes = sf_shape_calc_bytes(info->dtype, info->shape, info->ndim);
+        if (bytes == 0) continue;
+        state->reg_data[i] = state->allocator->alloc(state->allocator, bytes);
+        if (state->reg_data[i]) state->ownership_flags[i] = 1;
     }
+    return true;
 }
 
-static void sf_state_shutdown(sf_state* state, sf_backend* backend) {
+void sf_state_init_registers(sf_state* state, const sf_program* prog) {
+    if (!prog || !state->reg_data) return;
+    for (u32 i = 0; i < state->register_count; ++i) {
+        const sf_type_info* info = &prog->tensor_infos[i];
+        state->reg_ndims[i] = info->ndim;
+        state->reg_dtypes[i] = (uint8_t)info->dtype;
+        memcpy(&state->reg_shapes[i * SF_MAX_DIMS], info->shape, sizeof(i32) * SF_MAX_DIMS);
+
+        if (prog->tensor_data[i]) {
+            state->reg_data[i] = prog->tensor_data[i]; // Constants are owned by the program
+        } else if (state->ownership_flags[i]) {
+            // First touch happens here, on the worker that will set up this kernel
+            memset(state->reg_data[i], 0, sf_shape_calc_bytes(info->dtype, info->shape, info->ndim));
+        }
+    }
+}
+
+void sf_state_reset(sf_state* state, const sf_program* prog, sf_arena* arena) {
+    if (sf_state_reserve(state, prog, arena)) sf_state_init_registers(state, prog);
+}
+
+void sf_state_shutdown(sf_state* state, sf_backend* backend) {
     if (!state->reg_data || !state->allocator) return;
     
     if (backend && backend->free_baked && state->baked_data) {
@@ -107,18 +140,49 @@ sf_engine* sf_engine_create(const sf_engine_desc* desc) {
     size_t arena_size = (desc && desc->arena_size > 0) ? desc->arena_size : SF_MB(8);
     size_t heap_size = (desc && desc->heap_size > 0) ? desc->heap_size : SF_MB(64);
 
-    engine->arena_buffer = malloc(arena_size);
+    engine->arena_buffer = sf_vmem_reserve(arena_size);
     if (!engine->arena_buffer) { free(engine); return NULL; }
+    engine->arena_reserved = arena_size;
     sf_arena_init(&engine->arena, engine->arena_buffer, arena_size);
+    engine->meta_arena = &engine->arena;
 
-    engine->heap_buffer = malloc(heap_size);
-    if (!engine->heap_buffer) { free(engine->arena_buffer); free(engine); return NULL; }
+    engine->heap_buffer = sf_vmem_reserve(heap_size);
+    if (!engine->heap_buffer) { sf_vmem_release(engine->arena_buffer, arena_size); free(engine); return NULL; }
+    engine->heap_reserved = heap_size;
     sf_heap_init(&engine->heap, engine->heap_buffer, heap_size);
-
-    if (desc) engine->backend = desc->backend;
+    sf_engine_allocator_init(&engine->allocator, &engine->heap);
+
+    if (desc) {
+        engine->backend = desc->backend;
+        engine->release_on_reset = desc->release_on_reset;
+        sf_engine_allocator_configure(&engine->allocator, (int)desc->large_pages, desc->large_buffer_threshold, desc->numa_nodes);
+        if (desc->numa_nodes) {
+            sf_vmem_bind_numa(engine->arena_buffer, engine->arena_reserved, desc->numa_nodes);
+            sf_vmem_bind_numa(engine->heap_buffer, engine->heap_reserved, desc->numa_nodes);
+        }
+        engine->setup_threads = desc->setup_threads;
+        engine->bake_codec = desc->bake_codec;
+        // The codec may be described by short-lived storage; keep our own copy of its id
+        if (desc->bake_codec.backend_id) {
+            size_t len = strlen(desc->bake_codec.backend_id);
+            engine->bake_backend_id = malloc(len + 1);
+            if (engine->bake_backend_id) memcpy(engine->bake_backend_id, desc->bake_codec.backend_id, len + 1);
+            engine->bake_codec.backend_id = engine->bake_backend_id;
+        }
+        if (desc->bake_cache_dir && desc->bake_cache_dir[0]) {
+            size_t len = strlen(desc->bake_cache_dir);
+            engine->bake_cache_dir = malloc(len + 1);
+            if (engine->bake_cache_dir) {
+                memcpy(engine->bake_cache_dir, desc->bake_cache_dir, len + 1);
+                sf_fs_mkdir(engine->bake_cache_dir);
+            }
+        }
+    }
 
     engine->front_idx = 0;
     engine->back_idx = 1;
+    sf_atomic_store(&engine->refs, 1);
+    engine->batch_size = (desc && desc->batch_size > 1) ? desc->batch_size : 1;
     sf_atomic_store(&engine->error_code, 0);
 
     return engine;
@@ -126,29 +190,56 @@ sf_engine* sf_engine_create(const sf_engine_desc* desc) {
 
 void sf_engine_destroy(sf_engine* engine) {
     if (!engine) return;
+    // Clones hold references on their template; the last one out frees it
+    if (sf_atomic_i32_fetch_add(&engine->refs, -1) != 1) return;
     sf_engine_reset(engine);
-    if (engine->heap_buffer) free(engine->heap_buffer);
-    if (engine->arena_buffer) free(engine->arena_buffer);
+    sf_engine_disable_profiling(engine);
+    sf_bake_cache_shutdown(engine);
+    if (engine->heap_buffer) sf_vmem_release(engine->heap_buffer, engine->heap_reserved);
+    if (engine->arena_buffer) sf_vmem_release(engine->arena_buffer, engine->arena_reserved);
     free(engine);
 }
 
 void sf_engine_reset(sf_engine* engine) {
     if (!engine) return;
+    if ((u32)sf_atomic_load(&engine->refs) > 1) {
+        SF_LOG_ERROR("Engine: Cannot reset an engine with live clones.");
+        return;
+    }
+    sf_engine_cow_detach(engine);
 
     for (u32 i = 0; i < engine->kernel_count; ++i) {
         sf_state_shutdown(&engine->kernels[i].state, &engine->backend);
     }
 
     for (u32 i = 0; i < engine->resource_count; ++i) {
+        if (engine->resources[i].map_flags) {
+            sf_engine_unmap_file(&engine->resources[i]);
+            continue;
+        }
         if (engine->resources[i].buffers[0]) sf_buffer_free(engine->resources[i].buffers[0]);
         if (engine->resources[i].buffers[1] && engine->resources[i].buffers[1] != engine->resources[i].buffers[0]) {
             sf_buffer_free(engine->resources[i].buffers[1]);
         }
     }
+    sf_engine_track_arena(engine);
     sf_arena_reset(&engine->arena);
-    if (engine->heap_buffer) sf_heap_init(&engine->heap, engine->heap_buffer, engine->heap.size);
+    if (engine->release_on_reset) {
+        sf_vmem_decommit(engine->arena_buffer, engine->arena_reserved);
+        sf_vmem_decommit(engine->heap_buffer, engine->heap_reserved);
+    }
+    if (engine->heap_buffer) {
+        sf_heap_init(&engine->heap, engine->heap_buffer, engine->heap_reserved);
+        sf_engine_allocator_init(&engine->allocator, &engine->heap);
+    }
+    // The reload block came from the heap that was just re-initialized
+    engine->reload_block = NULL;
+    engine->meta_arena = &engine->arena;
     engine->kernel_count = 0;
+    engine->map_prefetch = false;
     engine->resource_count = 0;
+    sf_engine_release_programs(engine);
+    engine->roi_pending = false;
     sf_atomic_store(&engine->error_code, 0);
 }
 
@@ -156,48 +247,175 @@ sf_arena* sf_engine_get_arena(sf_engine* engine) {
     return engine ? &engine->arena : NULL;
 }
 
+static bool _kernel_only_screen(const sf_engine* engine, const sf_kernel_inst* ker) {
+    for (u32 b = 0; b < ker->binding_count; ++b) {
+        if (!(engine->resources[ker->bindings[b].global_res].flags & SF_RESOURCE_FLAG_SCREEN_SIZE)) return false;
+    }
+    return ker->binding_count > 0;
+}
+
+static bool _kernel_writes_screen(const sf_engine* engine, const sf_kernel_inst* ker) {
+    for (u32 b = 0; b < ker->binding_count; ++b) {
+        const sf_kernel_binding* bind = &ker->bindings[b];
+        if ((bind->flags & SF_SYMBOL_FLAG_OUTPUT) && (engine->resources[bind->global_res].flags & SF_RESOURCE_FLAG_SCREEN_SIZE)) return true;
+    }
+    return false;
+}
+
+static bool _kernel_roi(const sf_engine* engine, const sf_kernel_inst* ker) {
+    return (ker->flags & (SF_PIPELINE_KERNEL_ROI_SAFE | SF_PIPELINE_KERNEL_ELEMENTWISE)) && _kernel_writes_screen(engine, ker);
+}
+
+bool sf_engine_set_dirty_rows(sf_engine* engine, int32_t y, int32_t h) {
+    if (!engine) return false;
+    engine->roi_pending = false;
+    if (h <= 0) return true;
+    if (engine->batch_size > 1) return false;
+
+    bool any = false;
+    for (u32 k = 0; k < engine->kernel_count && !any; ++k) any = _kernel_roi(engine, &engine->kernels[k]);
+    if (!any) return false;
+
+    if (y < 0) { h += y; y = 0; }
+    i32 y0 = (y / SF_ENGINE_ROI_ROWS) * SF_ENGINE_ROI_ROWS;
+    i32 y1 = ((y + h + SF_ENGINE_ROI_ROWS - 1) / SF_ENGINE_ROI_ROWS) * SF_ENGINE_ROI_ROWS;
+    engine->roi_pending = (y1 > y0);
+    engine->roi_y0 = y0;
+    engine->roi_y1 = y1;
+    return engine->roi_pending;
+}
+
+/**
+ * Prepares a partial frame: carries rows outside the band forward into the back buffers
+ * of screen-size resources and publishes the band origin to u_TileOffset.
+ */
+static void _roi_prepare(sf_engine* engine) {
+    u8 front = engine->front_idx, back = engine->back_idx;
+    for (u32 i = 0; i < engine->resource_count; ++i) {
+        sf_resource_inst* res = &engine->resources[i];
+        if (!(res->flags & SF_RESOURCE_FLAG_SCREEN_SIZE) || res->desc.info.ndim == 0) continue;
+        if (res->buffers[front] == res->buffers[back] || !res->buffers[front] || !res->buffers[back]) continue;
+        if (!sf_engine_cow_write(engine, res, back, true)) continue;
+
+        i32 rows = res->desc.info.shape[0];
+        if (rows <= 0) continue;
+        size_t row_bytes = res->size_bytes / (size_t)rows;
+        i32 y0 = engine->roi_y0 < rows ? engine->roi_y0 : rows;
+        i32 y1 = engine->roi_y1 < rows ? engine->roi_y1 : rows;
+        u8* src = (u8*)res->buffers[front]->data;
+        u8* dst = (u8*)res->buffers[back]->data;
+        if (y0 > 0) memcpy(dst, src, (size_t)y0 * row_bytes);
+        if (y1 < rows) memcpy(dst + (size_t)y1 * row_bytes, src + (size_t)y1 * row_bytes, (size_t)(rows - y1) * row_bytes);
+    }
+
+    int32_t idx = find_resource_idx(engine, sf_fnv1a_hash("u_TileOffset"));
+    if (idx != -1) {
+        sf_resource_inst* res = &engine->resources[idx];
+        for (int b = 0; b < 2; ++b) {
+            if (!sf_engine_cow_write(engine, res, b, true)) continue;
+            if (!res->buffers[b] || !res->buffers[b]->data || res->size_bytes < 2 * sizeof(f32)) continue;
+            f32* d = (f32*)res->buffers[b]->data;
+            d[0] = 0.0f;
+            d[1] = (f32)engine->roi_y0;
+        }
+    }
+}
+
+static void _roi_clear_offset(sf_engine* engine) {
+    int32_t idx = find_resource_idx(engine, sf_fnv1a_hash("u_TileOffset"));
+    if (idx == -1) return;
+    sf_resource_inst* res = &engine->resources[idx];
+    for (int b = 0; b < 2; ++b) {
+        if (!sf_engine_cow_write(engine, res, b, true)) continue;
+        if (res->buffers[b] && res->buffers[b]->data && res->size_bytes >= 2 * sizeof(f32)) memset(res->buffers[b]->data, 0, 2 * sizeof(f32));
+    }
+}
+
 void sf_engine_dispatch(sf_engine* engine) {
     if (!engine || sf_atomic_load(&engine->error_code) != 0) return;
 
     u8 front = engine->front_idx;
     u8 back  = engine->back_idx;
 
+    bool roi = engine->roi_pending;
+    if (roi) _roi_prepare(engine);
+
+    struct sf_perf_ctx* perf = engine->perf;
+    bool perf_tasks = perf && sf_perf_per_task(perf);
+    sf_perf_sample ker_sample, task_sample;
+
     for (u32 k_idx = 0; k_idx < engine->kernel_count; ++k_idx) {
         sf_kernel_inst* ker = &engine->kernels[k_idx];
         if (sf_atomic_load(&engine->error_code) != 0) break;
-        
-        // 1. Resource Binding
-        for (u32 b = 0; b < ker->binding_count; ++b) {
-            sf_kernel_binding* bind = &ker->bindings[b];
-            sf_resource_inst* res = &engine->resources[bind->global_res];
-            
-            sf_buffer* buf = (bind->flags & SF_SYMBOL_FLAG_OUTPUT) ? res->buffers[back] : res->buffers[front];
-            ker->state.reg_data[bind->local_reg] = buf ? buf->data : NULL;
-            ker->state.reg_ndims[bind->local_reg] = res->desc.info.ndim;
-            ker->state.reg_dtypes[bind->local_reg] = (uint8_t)res->desc.info.dtype;
-            memcpy(&ker->state.reg_shapes[bind->local_reg * SF_MAX_DIMS], res->desc.info.shape, sizeof(i32) * SF_MAX_DIMS);
-        }
-        
-        // 2. Execution & Barrier Planning
-        for (u32 f = 0; f < ker->frequency; ++f) {
-            if (engine->backend.dispatch) {
-                ker->state.global_error_ptr = &engine->error_code;
-                for (u32 t = 0; t < ker->program->meta.task_count; ++t) {
-                    const sf_task* task = &ker->program->tasks[t];
-                    
-                    if (task->flags & SF_TASK_FLAG_BARRIER) {
-                        sf_backend_barrier(&engine->backend);
-                    }
+        // Kernels not marked ROI-safe still run over the full frame
+        bool ker_roi = roi && _kernel_roi(engine, ker);
+
+        // Batched mode: one pass per instance, or a single pass over stacked rows
+        bool fused = engine->batch_size > 1 && (ker->flags & SF_PIPELINE_KERNEL_ELEMENTWISE) && _kernel_only_screen(engine, ker);
+        u32 passes = fused ? 1 : engine->batch_size;
+
+        // Page in the next kernel's mapped inputs while this one runs
+        if (engine->map_prefetch) sf_engine_prefetch_kernel(engine, k_idx + 1 < engine->kernel_count ? k_idx + 1 : 0);
+
+        if (perf) sf_perf_read(perf, &ker_sample);
+        for (u32 inst = 0; inst < passes; ++inst) {
+            // 1. Resource Binding
+            for (u32 b = 0; b < ker->binding_count; ++b) {
+                sf_kernel_binding* bind = &ker->bindings[b];
+                sf_resource_inst* res = &engine->resources[bind->global_res];
+                if ((bind->flags & SF_SYMBOL_FLAG_OUTPUT) && !sf_engine_cow_write(engine, res, back, true)) goto end_dispatch;
+
+                sf_buffer* buf = (bind->flags & SF_SYMBOL_FLAG_OUTPUT) ? res->buffers[back] : res->buffers[front];
+                ker->state.reg_data[bind->local_reg] = buf ? buf->data : NULL;
+                ker->state.reg_ndims[bind->local_reg] = res->desc.info.ndim;
+                ker->state.reg_dtypes[bind->local_reg] = (uint8_t)res->desc.info.dtype;
+                memcpy(&ker->state.reg_shapes[bind->local_reg * SF_MAX_DIMS], res->desc.info.shape, sizeof(i32) * SF_MAX_DIMS);
+
+                if (fused) {
+                    ker->state.reg_shapes[bind->local_reg * SF_MAX_DIMS] *= (i32)engine->batch_size;
+                } else if (inst > 0 && buf && buf->data) {
+                    ker->state.reg_data[bind->local_reg] = (u8*)buf->data + (size_t)inst * sf_engine_instance_bytes(engine, res);
+                }
 
-                    // 3. Task specific state is ephemeral and managed by Backend dispatch
-                    engine->backend.dispatch(engine->backend.state, ker->program, &ker->state, NULL, task);
-                    if (sf_atomic_load(&engine->error_code) != 0) goto end_dispatch;
+                // Partial frame: view only the dirty row band (row-major [H, W, ...])
+                if (ker_roi && buf && (res->flags & SF_RESOURCE_FLAG_SCREEN_SIZE) && res->desc.info.ndim > 0) {
+                    i32 rows = res->desc.info.shape[0];
+                    i32 y0 = engine->roi_y0 < rows ? engine->roi_y0 : rows;
+                    i32 y1 = engine->roi_y1 < rows ? engine->roi_y1 : rows;
+                    size_t row_bytes = rows > 0 ? res->size_bytes / (size_t)rows : 0;
+                    ker->state.reg_data[bind->local_reg] = (u8*)buf->data + (size_t)y0 * row_bytes;
+                    ker->state.reg_shapes[bind->local_reg * SF_MAX_DIMS] = y1 - y0;
+                }
+            }
+
+            // 2. Execution & Barrier Planning
+            for (u32 f = 0; f < ker->frequency; ++f) {
+                if (engine->backend.dispatch) {
+                    ker->state.global_error_ptr = &engine->error_code;
+                    for (u32 t = 0; t < ker->program->meta.task_count; ++t) {
+                        const sf_task* task = &ker->program->tasks[t];
+
+                        if (task->flags & SF_TASK_FLAG_BARRIER) {
+                            sf_backend_barrier(&engine->backend);
+                        }
+
+                        // 3. Task specific state is ephemeral and managed by Backend dispatch
+                        if (perf_tasks) sf_perf_read(perf, &task_sample);
+                        engine->backend.dispatch(engine->backend.state, ker->program, &ker->state, NULL, task);
+                        if (perf_tasks) sf_perf_accumulate(perf, k_idx, ker->id_hash, (i32)t, &task_sample);
+                        if (sf_atomic_load(&engine->error_code) != 0) goto end_dispatch;
+                    }
                 }
             }
         }
+        if (perf) sf_perf_accumulate(perf, k_idx, ker->id_hash, -1, &ker_sample);
     }
     
 end_dispatch:
+    if (roi) {
+        engine->roi_pending = false;
+        _roi_clear_offset(engine);
+    }
     engine->frame_index++;
     engine->front_idx = 1 - engine->front_idx;
     engine->back_idx  = 1 - engine->back_idx;
@@ -208,6 +426,8 @@ sf_tensor* sf_engine_map_resource(sf_engine* engine, const char* name) {
     for (u32 i = 0; i < engine->resource_count; ++i) {
         if (strcmp(engine->resources[i].name, name) == 0) {
             sf_resource_inst* res = &engine->resources[i];
+            // The host may write through the mapping: clones take private copies first
+            if (res->cow_mask && (!sf_engine_cow_write(engine, res, 0, true) || !sf_engine_cow_write(engine, res, 1, true))) return NULL;
             res->desc.buffer = res->buffers[engine->front_idx];
             res->desc.byte_offset = 0;
             return &res->desc;
@@ -216,45 +436,165 @@ sf_tensor* sf_engine_map_resource(sf_engine* engine, const char* name) {
     return NULL;
 }
 
-bool sf_engine_resize_resource(sf_engine* engine, const char* name, const int32_t* new_shape, uint8_t new_ndim) {
+uint32_t sf_engine_get_batch_size(sf_engine* engine) {
+    return engine ? engine->batch_size : 0;
+}
+
+bool sf_engine_map_instance(sf_engine* engine, const char* name, uint32_t instance, sf_tensor* out_view) {
+    if (!engine || !name || !out_view || instance >= engine->batch_size) return false;
+    sf_tensor* t = sf_engine_map_resource(engine, name);
+    if (!t) return false;
+    int32_t idx = find_resource_idx(engine, sf_fnv1a_hash(name));
+    *out_view = *t;
+    out_view->byte_offset = (size_t)instance * sf_engine_instance_bytes(engine, &engine->resources[idx]);
+    return true;
+}
+
+bool sf_engine_broadcast_instance(sf_engine* engine, const char* name) {
     if (!engine || !name) return false;
-    u32 hash = sf_fnv1a_hash(name);
-    int32_t res_idx = find_resource_idx(engine, hash);
-    if (res_idx == -1) {
-        SF_LOG_ERROR("Engine: Cannot resize resource '%s' - not found.", name);
-        return false;
+    int32_t idx = find_resource_idx(engine, sf_fnv1a_hash(name));
+    if (idx == -1) return false;
+    if (engine->batch_size <= 1) return true;
+
+    sf_resource_inst* res = &engine->resources[idx];
+    if (!sf_engine_cow_write(engine, res, engine->front_idx, true)) return false;
+    sf_buffer* buf = res->buffers[engine->front_idx];
+    if (!buf || !buf->data) return false;
+    size_t bytes = sf_engine_instance_bytes(engine, res);
+    for (u32 inst = 1; inst < engine->batch_size; ++inst) memcpy((u8*)buf->data + (size_t)inst * bytes, buf->data, bytes);
+    return true;
+}
+
+bool sf_engine_is_resource_read(sf_engine* engine, const char* name) {
+    if (!engine || !name) return false;
+    int32_t res_idx = find_resource_idx(engine, sf_fnv1a_hash(name));
+    if (res_idx == -1) return false;
+    for (u32 k = 0; k < engine->kernel_count; ++k) {
+        sf_kernel_inst* ker = &engine->kernels[k];
+        for (u32 b = 0; b < ker->binding_count; ++b) {
+            if (ker->bindings[b].global_res == (u16)res_idx && (ker->bindings[b].flags & SF_SYMBOL_FLAG_INPUT)) return true;
+        }
     }
+    return false;
+}
 
-    sf_resource_inst* res = &engine->resources[res_idx];
-    sf_allocator* alloc = (sf_allocator*)&engine->heap;
+bool sf_engine_is_frame_independent(sf_engine* engine) {
+    if (!engine) return false;
+    for (u32 r = 0; r < engine->resource_count; ++r) {
+        // Transient resources are always written before they are read within a frame
+        if (engine->resources[r].flags & SF_RESOURCE_FLAG_TRANSIENT) continue;
+
+        bool read = false, written = false;
+        for (u32 k = 0; k < engine->kernel_count; ++k) {
+            sf_kernel_inst* ker = &engine->kernels[k];
+            for (u32 b = 0; b < ker->binding_count; ++b) {
+                if (ker->bindings[b].global_res != (u16)r) continue;
+                if (ker->bindings[b].flags & SF_SYMBOL_FLAG_INPUT) read = true;
+                if (ker->bindings[b].flags & SF_SYMBOL_FLAG_OUTPUT) written = true;
+            }
+        }
+        if (read && written) return false;
+    }
+    return true;
+}
+
+/**
+ * Re-shapes a resource, keeping its blocks while they fit. With headroom, growth
+ * over-allocates so that a sequence of growing resizes (window drags) settles quickly.
+ */
+static bool _resize_resource_inst(sf_engine* engine, sf_resource_inst* res, const int32_t* new_shape, uint8_t new_ndim, bool headroom) {
+    sf_allocator* alloc = sf_engine_alloc(engine);
+    if (res->map_flags) {
+        SF_LOG_ERROR("Engine: Resource '%s' is mapped from '%s' and cannot be resized.", res->name, res->map_path);
+        return false;
+    }
     
     sf_type_info new_info;
     sf_type_info_init_contiguous(&new_info, (sf_dtype)res->desc.info.dtype, new_shape, new_ndim);
-    size_t new_bytes = sf_shape_calc_count(new_shape, new_ndim) * sf_dtype_size(new_info.dtype);
+    size_t new_bytes = sf_shape_calc_count(new_shape, new_ndim) * sf_dtype_size(new_info.dtype) * engine->batch_size;
     
-    if (res->size_bytes != new_bytes) {
-        bool is_transient = (res->buffers[0] == res->buffers[1]);
+    // Borrowed clone data is never freed here, it just stops being referenced
+    sf_engine_cow_invalidate(engine);
+    for (int b = 0; b < 2; ++b) {
+        if ((res->cow_mask & (1u << b)) && res->buffers[b]) res->buffers[b]->data = NULL;
+    }
+    res->cow_mask = 0;
+
+    // Reuse existing blocks when they are large enough and not grossly oversized
+    bool is_transient = (res->buffers[0] == res->buffers[1]);
+    bool fits = true;
+    for (int b = 0; b < (is_transient ? 1 : 2); ++b) {
+        size_t cap = (res->buffers[b] && res->buffers[b]->data) ? sf_engine_allocator_capacity(res->buffers[b]->data) : 0;
+        if (cap < new_bytes || (cap > SF_KB(64) && new_bytes < cap / 4)) fits = false;
+    }
+
+    if (!fits) {
+        size_t alloc_bytes = (headroom && new_bytes > res->size_bytes) ? new_bytes + new_bytes / 4 : new_bytes;
         if (res->buffers[0] && res->buffers[0]->data) sf_buffer_free(res->buffers[0]);
-        if (!sf_buffer_alloc(res->buffers[0], alloc, new_bytes)) return false;
+        if (!sf_buffer_alloc(res->buffers[0], alloc, alloc_bytes)) return false;
         
         if (is_transient) res->buffers[1] = res->buffers[0];
         else {
             if (res->buffers[1] && res->buffers[1]->data) sf_buffer_free(res->buffers[1]);
-            if (!sf_buffer_alloc(res->buffers[1], alloc, new_bytes)) return false;
+            if (!sf_buffer_alloc(res->buffers[1], alloc, alloc_bytes)) return false;
         }
-        res->size_bytes = new_bytes;
     }
+    // Buffers report the live size; spare capacity stays with the allocator block
+    for (int b = 0; b < 2; ++b) {
+        if (res->buffers[b]) res->buffers[b]->size_bytes = new_bytes;
+    }
+    res->size_bytes = new_bytes;
     res->desc.info = new_info;
     return true;
 }
 
+bool sf_engine_resize_resource(sf_engine* engine, const char* name, const int32_t* new_shape, uint8_t new_ndim) {
+    if (!engine || !name) return false;
+    u32 hash = sf_fnv1a_hash(name);
+    int32_t res_idx = find_resource_idx(engine, hash);
+    if (res_idx == -1) {
+        SF_LOG_ERROR("Engine: Cannot resize resource '%s' - not found.", name);
+        return false;
+    }
+    return _resize_resource_inst(engine, &engine->resources[res_idx], new_shape, new_ndim, false);
+}
+
+bool sf_engine_resize_screen(sf_engine* engine, int32_t width, int32_t height) {
+    if (!engine || width <= 0 || height <= 0) return false;
+    bool ok = true;
+
+    // Reshape every screen-dependent resource: [H, W, ...trailing dims].
+    // Kernel views are rebuilt from the resources on every dispatch, so nothing else changes here.
+    for (u32 i = 0; i < engine->resource_count; ++i) {
+        sf_resource_inst* res = &engine->resources[i];
+        if (!(res->flags & SF_RESOURCE_FLAG_SCREEN_SIZE) || res->desc.info.ndim == 0) continue;
+
+        int32_t shape[SF_MAX_DIMS];
+        uint8_t ndim = res->desc.info.ndim;
+        memcpy(shape, res->desc.info.shape, sizeof(int32_t) * SF_MAX_DIMS);
+        shape[0] = height;
+        if (ndim >= 2) shape[1] = width;
+        if (memcmp(shape, res->desc.info.shape, sizeof(int32_t) * ndim) == 0) continue;
+
+        if (!_resize_resource_inst(engine, res, shape, ndim, true)) {
+            SF_LOG_ERROR("Engine: Failed to resize screen resource '%s' to %dx%d.", res->name, width, height);
+            ok = false;
+        }
+    }
+    // Some resources may already have the new size; dispatching a mix would read out of bounds
+    if (!ok) sf_atomic_store(&engine->error_code, SF_ENGINE_ERR_OOM);
+    return ok;
+}
+
 void sf_engine_sync_resource(sf_engine* engine, const char* name) {
     if (!engine || !name) return;
     u32 hash = sf_fnv1a_hash(name);
     int32_t idx = find_resource_idx(engine, hash);
     if (idx == -1) return;
     sf_resource_inst* res = &engine->resources[idx];
+    sf_engine_cow_invalidate(engine);
     if (res->buffers[0] && res->buffers[1] && res->buffers[0] != res->buffers[1]) {
+        if (!sf_engine_cow_write(engine, res, 1 - engine->front_idx, false)) return;
         if (res->buffers[0]->data && res->buffers[1]->data) {
             memcpy(res->buffers[1 - engine->front_idx]->data, res->buffers[engine->front_idx]->data, res->size_bytes);
         }
@@ -0,0 +1,217 @@
+#include "sf_engine_internal.h"
+#include "sf_vmem.h"
+#include <string.h>
+
+/**
+ * Engine-side allocator layered over sf_heap.
+ *
+ * Requests up to SF_POOL_MAX_CLASS are rounded to a size class (4 classes per power
+ * of two) and freed blocks are kept on per-class free lists, so resize churn reuses
+ * blocks instead of fragmenting the heap. Larger requests go straight to the heap.
+ * Every block starts on a SF_ENGINE_ALLOC_ALIGN boundary and carries a header with its
+ * size, which also drives accounting for sf_engine_get_memory_stats.
+ * With a large page mode configured, buffers above the threshold get their own
+ * (huge page, NUMA bound) mapping instead of heap space.
+ */
+
+#define SF_POOL_MIN_CLASS   64u
+#define SF_POOL_MAX_CLASS   SF_MB(64)
+#define SF_POOL_NO_CLASS    0xFFFFFFFFu
+#define SF_POOL_MAPPED      0xFFFFFFFEu
+#define SF_ALLOC_MAGIC      0x53464131u // "SFA1"
+
+typedef struct sf_alloc_header {
+    void*  raw;          // Pointer returned by the heap (or mapping base)
+    size_t mapped_size;  // Mapping length for SF_POOL_MAPPED blocks
+    size_t size;         // Requested bytes
+    size_t capacity;     // Usable bytes (class size)
+    struct sf_alloc_header* next_free;
+    u32    class_idx;
+    u32    magic;
+} sf_alloc_header;
+
+#define SF_ALLOC_HEADER_SPACE (((sizeof(sf_alloc_header) + SF_ENGINE_ALLOC_ALIGN - 1) / SF_ENGINE_ALLOC_ALIGN) * SF_ENGINE_ALLOC_ALIGN)
+
+static sf_alloc_header* _header_of(void* ptr) {
+    return (sf_alloc_header*)((u8*)ptr - sizeof(sf_alloc_header));
+}
+
+// --- Size Classes ---
+
+static u32 _class_index(size_t size, size_t* out_class_size) {
+    if (size > SF_POOL_MAX_CLASS) return SF_POOL_NO_CLASS;
+    if (size < SF_POOL_MIN_CLASS) size = SF_POOL_MIN_CLASS;
+
+    // Power-of-two bucket, split into 4 linear steps
+    u32 shift = 0;
+    while (((size_t)SF_POOL_MIN_CLASS << (shift + 1)) < size) shift++;
+    size_t base = (size_t)SF_POOL_MIN_CLASS << shift;
+    size_t step = base / 4;
+    size_t sub = (size - base + step - 1) / step;
+    if (sub > 4) sub = 4;
+
+    *out_class_size = base + sub * step;
+    return shift * 4 + (u32)sub;
+}
+
+// --- Heap Access ---
+
+static sf_alloc_header* _heap_block(sf_engine_allocator* a, size_t capacity) {
+    sf_allocator* heap = (sf_allocator*)a->heap;
+    size_t total = capacity + SF_ALLOC_HEADER_SPACE + SF_ENGINE_ALLOC_ALIGN;
+    u8* raw = heap->alloc(heap, total);
+    if (!raw) {
+        // Cached blocks may be what is in the way
+        sf_engine_allocator_trim(a);
+        raw = heap->alloc(heap, total);
+        if (!raw) return NULL;
+    }
+
+    size_t user = ((size_t)raw + SF_ALLOC_HEADER_SPACE + SF_ENGINE_ALLOC_ALIGN - 1) & ~(size_t)(SF_ENGINE_ALLOC_ALIGN - 1);
+    sf_alloc_header* h = _header_of((void*)user);
+    h->raw = raw;
+    h->capacity = capacity;
+    h->magic = SF_ALLOC_MAGIC;
+    h->next_free = NULL;
+    return h;
+}
+
+static void _heap_release(sf_engine_allocator* a, sf_alloc_header* h) {
+    sf_allocator* heap = (sf_allocator*)a->heap;
+    h->magic = 0;
+    heap->free(heap, h->raw);
+}
+
+static sf_alloc_header* _mapped_block(sf_engine_allocator* a, size_t size) {
+    size_t mapped = 0;
+    u8* base = sf_vmem_map_large(size + SF_ALLOC_HEADER_SPACE, a->large_pages, &mapped);
+    if (!base) return NULL;
+    if (a->numa_nodes) sf_vmem_bind_numa(base, mapped, a->numa_nodes);
+
+    sf_alloc_header* h = _header_of(base + SF_ALLOC_HEADER_SPACE);
+    h->raw = base;
+    h->mapped_size = mapped;
+    h->capacity = mapped - SF_ALLOC_HEADER_SPACE;
+    h->magic = SF_ALLOC_MAGIC;
+    h->next_free = NULL;
+    return h;
+}
+
+// --- Allocator Interface ---
+
+static void* _engine_alloc(sf_allocator* self, size_t size) {
+    sf_engine_allocator* a = (sf_engine_allocator*)self;
+    size_t capacity = size;
+    u32 cls = _class_index(size, &capacity);
+
+    sf_alloc_header* h = NULL;
+    if (a->large_pages && size >= a->large_threshold) {
+        h = _mapped_block(a, size);
+        if (h) cls = SF_POOL_MAPPED;
+    }
+    if (!h && cls < SF_POOL_CLASS_COUNT && a->free_lists[cls]) {
+        h = a->free_lists[cls];
+        a->free_lists[cls] = h->next_free;
+        a->cached -= h->capacity;
+        h->next_free = NULL;
+    } else if (!h) {
+        h = _heap_block(a, capacity);
+        if (!h) return NULL;
+    }
+
+    // Buffers may go straight to file or socket I/O, which cannot commit pages on demand
+    if (!sf_vmem_commit(h, sizeof(sf_alloc_header) + h->capacity)) {
+        if (cls == SF_POOL_MAPPED) sf_vmem_release(h->raw, h->mapped_size);
+        else _heap_release(a, h);
+        return NULL;
+    }
+
+    h->size = size;
+    h->class_idx = (cls < SF_POOL_CLASS_COUNT || cls == SF_POOL_MAPPED) ? cls : SF_POOL_NO_CLASS;
+    a->used += h->capacity;
+    a->alloc_count++;
+    if (a->used + a->cached > a->peak) a->peak = a->used + a->cached;
+    return (u8*)h + sizeof(sf_alloc_header);
+}
+
+static void _engine_free(sf_allocator* self, void* ptr) {
+    if (!ptr) return;
+    sf_engine_allocator* a = (sf_engine_allocator*)self;
+    sf_alloc_header* h = _header_of(ptr);
+    if (h->magic != SF_ALLOC_MAGIC) return;
+
+    a->used = (a->used >= h->capacity) ? a->used - h->capacity : 0;
+    if (a->alloc_count > 0) a->alloc_count--;
+
+    if (h->class_idx == SF_POOL_MAPPED) {
+        h->magic = 0;
+        sf_vmem_release(h->raw, h->mapped_size);
+        return;
+    }
+    if (h->class_idx != SF_POOL_NO_CLASS) {
+        h->next_free = a->free_lists[h->class_idx];
+        a->free_lists[h->class_idx] = h;
+        a->cached += h->capacity;
+        return;
+    }
+    _heap_release(a, h);
+}
+
+void sf_engine_allocator_init(sf_engine_allocator* a, sf_heap* heap) {
+    size_t peak = a->peak;
+    int large_pages = a->large_pages;
+    size_t large_threshold = a->large_threshold;
+    u64 numa_nodes = a->numa_nodes;
+
+    memset(a, 0, sizeof(sf_engine_allocator));
+    a->base.alloc = _engine_alloc;
+    a->base.free = _engine_free;
+    a->heap = heap;
+    a->peak = peak; // High-water survives heap resets
+    a->large_pages = large_pages;
+    a->large_threshold = large_threshold;
+    a->numa_nodes = numa_nodes;
+}
+
+void sf_engine_allocator_configure(sf_engine_allocator* a, int large_pages, size_t large_threshold, u64 numa_nodes) {
+    a->large_pages = large_pages;
+    a->large_threshold = large_threshold ? large_threshold : SF_MB(2);
+    a->numa_nodes = numa_nodes;
+}
+
+void sf_engine_allocator_trim(sf_engine_allocator* a) {
+    for (u32 c = 0; c < SF_POOL_CLASS_COUNT; ++c) {
+        sf_alloc_header* h = a->free_lists[c];
+        while (h) {
+            sf_alloc_header* next = h->next_free;
+            _heap_release(a, h);
+            h = next;
+        }
+        a->free_lists[c] = NULL;
+    }
+    a->cached = 0;
+}
+
+size_t sf_engine_allocator_capacity(const void* ptr) {
+    if (!ptr) return 0;
+    sf_alloc_header* h = _header_of((void*)ptr);
+    return (h->magic == SF_ALLOC_MAGIC) ? h->capacity : 0;
+}
+
+size_t sf_engine_allocator_largest_free(sf_engine_allocator* a, size_t upper_bound) {
+    sf_allocator* heap = (sf_allocator*)a->heap;
+    size_t lo = 0, hi = upper_bound;
+    // Binary search for the largest block the heap can still hand out
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo + 1) / 2;
+        void* p = heap->alloc(heap, mid);
+        if (p) { heap->free(heap, p); lo = mid; }
+        else hi = mid - 1;
+    }
+    return lo;
+}
+
+void sf_engine_trim(sf_engine* engine) {
+    if (!engine) return;
+    sf_engine_allocator_trim(&engine->allocator);
+}
@@ -0,0 +1,254 @@
+#include <sionflow/engine/sf_engine.h>
+#include <sionflow/engine/sf_thread.h>
+#include "sf_engine_internal.h"
+#include <sionflow/base/sf_log.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Copy-on-write cloning.
+ *
+ * A clone shares its source's programs, bindings and bake results (the source is kept
+ * alive through its reference count) and starts from an immutable capture of the
+ * source's resources. The capture lives outside any engine heap, so clones on other
+ * threads can drop it without touching the source's allocator.
+ */
+
+typedef struct sf_cow_image {
+    sf_atomic_i32 refs;
+    u64          frame_index; // Source frame the capture was taken at
+    void*        block;       // Unaligned allocation
+    void**       data;        // Per resource (NULL: transient, empty or unallocated)
+    size_t*      sizes;       // Per resource size_bytes at capture time
+    u32          count;       // Resources captured
+} sf_cow_image;
+
+static void _image_release(sf_cow_image* image) {
+    if (!image || sf_atomic_i32_fetch_add(&image->refs, -1) != 1) return;
+    free(image->block);
+    free(image->data);
+    free(image->sizes);
+    free(image);
+}
+
+static bool _is_transient(const sf_resource_inst* res) {
+    return res->buffers[0] == res->buffers[1];
+}
+
+static size_t _align(size_t v) {
+    return (v + SF_ENGINE_ALLOC_ALIGN - 1) & ~(size_t)(SF_ENGINE_ALLOC_ALIGN - 1);
+}
+
+static sf_cow_image* _capture(sf_engine* engine) {
+    // The cache stays valid until the next frame or host write (see sf_engine_cow_invalidate)
+    if (engine->cow_cache && engine->cow_cache->frame_index == engine->frame_index) return engine->cow_cache;
+    sf_engine_cow_invalidate(engine);
+
+    sf_cow_image* image = calloc(1, sizeof(sf_cow_image));
+    if (!image) return NULL;
+    image->data = calloc(engine->resource_count + 1, sizeof(void*));
+    image->sizes = calloc(engine->resource_count + 1, sizeof(size_t));
+    image->frame_index = engine->frame_index;
+    image->count = engine->resource_count;
+
+    size_t total = 0;
+    for (u32 i = 0; i < engine->resource_count; ++i) {
+        sf_resource_inst* res = &engine->resources[i];
+        if (!_is_transient(res) && !res->map_flags) total += _align(res->size_bytes);
+    }
+    image->block = total ? malloc(total + SF_ENGINE_ALLOC_ALIGN) : NULL;
+    if (!image->data || !image->sizes || (total && !image->block)) {
+        free(image->block);
+        free(image->data);
+        free(image->sizes);
+        free(image);
+        return NULL;
+    }
+
+    u8* cursor = (u8*)_align((size_t)(uintptr_t)image->block);
+    for (u32 i = 0; i < engine->resource_count; ++i) {
+        sf_resource_inst* res = &engine->resources[i];
+        sf_buffer* front = res->buffers[engine->front_idx];
+        image->sizes[i] = res->size_bytes;
+        // Read-only mappings outlive the capture (the source holds them), so share them as-is
+        if (res->map_flags && front) {
+            image->data[i] = front->data;
+            continue;
+        }
+        if (_is_transient(res) || res->size_bytes == 0 || !front || !front->data) continue;
+        memcpy(cursor, front->data, res->size_bytes);
+        image->data[i] = cursor;
+        cursor += _align(res->size_bytes);
+    }
+
+    sf_atomic_store(&image->refs, 1); // Held by the cache
+    engine->cow_cache = image;
+    return image;
+}
+
+void sf_engine_cow_invalidate(sf_engine* engine) {
+    _image_release(engine->cow_cache);
+    engine->cow_cache = NULL;
+}
+
+bool sf_engine_cow_own(sf_engine* engine, sf_resource_inst* res, int b, bool copy) {
+    sf_buffer* buf = res->buffers[b];
+    if (!buf) return false;
+    const void* shared = buf->data;
+    bool single = _is_transient(res);
+
+    memset(buf, 0, sizeof(sf_buffer));
+    if (res->size_bytes > 0 && !sf_buffer_alloc(buf, sf_engine_alloc(engine), res->size_bytes)) {
+        SF_LOG_ERROR("Engine: Out of memory materializing clone buffer of '%s'.", res->name);
+        sf_atomic_store(&engine->error_code, SF_ERROR_OOM);
+        res->cow_mask &= (u8)~(single ? 3u : (1u << b));
+        return false;
+    }
+    if (buf->data) {
+        if (copy && shared) memcpy(buf->data, shared, res->size_bytes);
+        else memset(buf->data, 0, res->size_bytes);
+    }
+    res->cow_mask &= (u8)~(single ? 3u : (1u << b));
+    return true;
+}
+
+void sf_engine_set_rewind_point(sf_engine* engine) {
+    if (!engine) return;
+    // The rewind point is just a capture that outlives the clone cache
+    sf_cow_image* image = _capture(engine);
+    if (!image) {
+        SF_LOG_ERROR("Engine: Out of memory saving the rewind point.");
+        return;
+    }
+    sf_atomic_i32_fetch_add(&image->refs, 1);
+    sf_engine_drop_rewind_point(engine);
+    engine->rewind_point = image;
+}
+
+void sf_engine_drop_rewind_point(sf_engine* engine) {
+    _image_release(engine->rewind_point);
+    engine->rewind_point = NULL;
+}
+
+const void* sf_engine_rewind_data(const sf_engine* engine, u32 res_idx) {
+    const sf_cow_image* image = engine->rewind_point;
+    if (!image || res_idx >= image->count || image->sizes[res_idx] != engine->resources[res_idx].size_bytes) return NULL;
+    return image->data[res_idx];
+}
+
+void sf_engine_cow_detach(sf_engine* engine) {
+    for (u32 i = 0; i < engine->resource_count; ++i) {
+        sf_resource_inst* res = &engine->resources[i];
+        for (int b = 0; b < 2; ++b) {
+            if ((res->cow_mask & (1u << b)) && res->buffers[b]) res->buffers[b]->data = NULL;
+        }
+        res->cow_mask = 0;
+    }
+    // Bakes belong to the template
+    if (engine->clone_template) {
+        for (u32 k = 0; k < engine->kernel_count; ++k) engine->kernels[k].state.baked_data = NULL;
+    }
+
+    sf_engine_cow_invalidate(engine);
+    sf_engine_drop_rewind_point(engine);
+    _image_release(engine->cow_source);
+    engine->cow_source = NULL;
+    if (engine->clone_template) {
+        sf_engine* template_engine = engine->clone_template;
+        engine->clone_template = NULL;
+        sf_engine_destroy(template_engine);
+    }
+}
+
+sf_engine* sf_engine_clone(sf_engine* source) {
+    if (!source || (source->kernel_count == 0 && source->resource_count == 0)) {
+        SF_LOG_ERROR("Engine: Nothing to clone, no pipeline bound.");
+        return NULL;
+    }
+    if (sf_atomic_load(&source->error_code) != 0) {
+        SF_LOG_ERROR("Engine: Refusing to clone an engine in error state.");
+        return NULL;
+    }
+    for (u32 i = 0; i < source->resource_count; ++i) {
+        if (source->resources[i].map_flags & SF_RESOURCE_MAP_WRITE) {
+            SF_LOG_ERROR("Engine: Cannot clone, resource '%s' is mapped read/write.", source->resources[i].name);
+            return NULL;
+        }
+    }
+
+    sf_engine_desc desc = {
+        .arena_size = source->arena_reserved,
+        .heap_size = source->heap_reserved,
+        .release_on_reset = source->release_on_reset,
+        .backend = source->backend,
+        .setup_threads = source->setup_threads,
+        .large_pages = (sf_engine_page_mode)source->allocator.large_pages,
+        .large_buffer_threshold = source->allocator.large_threshold,
+        .numa_nodes = source->allocator.numa_nodes,
+        .batch_size = source->batch_size
+    };
+    sf_engine* clone = sf_engine_create(&desc);
+    if (!clone) return NULL;
+
+    sf_cow_image* image = _capture(source);
+    clone->resources = SF_ARENA_PUSH(&clone->arena, sf_resource_inst, source->resource_count);
+    clone->kernels = SF_ARENA_PUSH(&clone->arena, sf_kernel_inst, source->kernel_count);
+    if (!image || (!clone->resources && source->resource_count) || (!clone->kernels && source->kernel_count)) {
+        SF_LOG_ERROR("Engine: Out of memory while cloning.");
+        sf_engine_destroy(clone);
+        return NULL;
+    }
+
+    // Programs, ids and bindings live in the template's arena; hold it until detach
+    sf_engine* template_engine = source->clone_template ? source->clone_template : source;
+    sf_atomic_i32_fetch_add(&template_engine->refs, 1);
+    clone->clone_template = template_engine;
+    sf_atomic_i32_fetch_add(&image->refs, 1);
+    clone->cow_source = image;
+    if (source->rewind_point) {
+        sf_atomic_i32_fetch_add(&source->rewind_point->refs, 1);
+        clone->rewind_point = source->rewind_point;
+    }
+
+    // 1. Resources borrow the captured data (both buffers read the same bytes until written)
+    memcpy(clone->resources, source->resources, sizeof(sf_resource_inst) * source->resource_count);
+    clone->resource_count = source->resource_count;
+    for (u32 i = 0; i < clone->resource_count; ++i) {
+        clone->resources[i].buffers[0] = clone->resources[i].buffers[1] = NULL;
+        clone->resources[i].cow_mask = 3;
+        clone->resources[i].map_flags = 0; // The mapping belongs to the source
+    }
+    for (u32 i = 0; i < clone->resource_count; ++i) {
+        sf_resource_inst* res = &clone->resources[i];
+        bool single = _is_transient(&source->resources[i]);
+        for (int b = 0; b < (single ? 1 : 2); ++b) {
+            res->buffers[b] = SF_ARENA_PUSH(&clone->arena, sf_buffer, 1);
+            if (!res->buffers[b]) {
+                sf_engine_destroy(clone);
+                return NULL;
+            }
+            memset(res->buffers[b], 0, sizeof(sf_buffer));
+            res->buffers[b]->data = image->data[i];
+        }
+        if (single) res->buffers[1] = res->buffers[0];
+        res->desc.buffer = res->buffers[source->front_idx];
+        res->desc.byte_offset = 0;
+    }
+
+    // 2. Kernels: own scratch registers, shared program and bake
+    memcpy(clone->kernels, source->kernels, sizeof(sf_kernel_inst) * source->kernel_count);
+    clone->kernel_count = source->kernel_count;
+    for (u32 k = 0; k < clone->kernel_count; ++k) {
+        sf_kernel_inst* ker = &clone->kernels[k];
+        memset(&ker->state, 0, sizeof(sf_state));
+        ker->state.allocator = sf_engine_alloc(clone);
+        sf_state_reset(&ker->state, ker->program, &clone->arena);
+        ker->state.baked_data = source->kernels[k].state.baked_data;
+    }
+
+    clone->front_idx = source->front_idx;
+    clone->back_idx = source->back_idx;
+    clone->frame_index = source->frame_index;
+    sf_engine_track_arena(clone);
+    return clone;
+}
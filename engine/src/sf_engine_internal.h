@@ -24,8 +24,11 @@ typedef struct {
     const char* id;
     u32         id_hash;
     sf_program* program;
+    u64         program_hash; // Content hash (0 = unknown, bake is not cached)
+    size_t      baked_size;   // Serialized bake size (0 = unknown)
     sf_state    state;       // Local registers and memory
     uint32_t    frequency;   // Execution frequency per frame
+    u32         flags;       // SF_PIPELINE_KERNEL_*
     
     sf_kernel_binding* bindings;
     u32                binding_count;
@@ -38,23 +41,95 @@ typedef struct {
     const char* name;
     u32         name_hash;
     sf_buffer*  buffers[2];   // [0] Front, [1] Back
-    size_t      size_bytes;
-    sf_tensor   desc;         // Metadata and current view
+    size_t      size_bytes;   // All instances (batch_size * per-instance bytes)
+    sf_tensor   desc;         // Metadata and current view (per-instance shape)
+    sf_type_info decl_info;   // Layout as declared at bind time (before runtime resizes)
     u8          flags;        // SF_RESOURCE_FLAG_*
+    u8          cow_mask;     // Bit b: buffers[b] borrows data from a shared clone image
+    u8          map_flags;    // SF_RESOURCE_MAP_*: single buffer backed by map_path
+    bool        reload_kept;  // Contents carried over by the last hot reload
+    const char* map_path;
 } sf_resource_inst;
 
+#define SF_ENGINE_ALLOC_ALIGN 64u  // Cache line / widest SIMD register
+#define SF_POOL_CLASS_COUNT   96u
+
+struct sf_alloc_header;
+
+/**
+ * @brief Size-class pool allocator layered over the heap.
+ * Every engine-owned heap allocation (resources, kernel registers) goes through it.
+ * Also provides the accounting for sf_engine_get_memory_stats.
+ */
+typedef struct {
+    sf_allocator base;        // Must be first (castable to sf_allocator*)
+    sf_heap*     heap;
+    size_t       used;        // Live bytes handed out (class capacity)
+    size_t       cached;      // Bytes parked on free lists
+    size_t       peak;        // High-water of used + cached
+    u32          alloc_count; // Live allocations
+    struct sf_alloc_header* free_lists[SF_POOL_CLASS_COUNT];
+
+    // Large buffer backing (kept across heap resets)
+    int          large_pages;     // sf_engine_page_mode
+    size_t       large_threshold;
+    u64          numa_nodes;
+} sf_engine_allocator;
+
+/**
+ * @brief Serialized bake result kept across resets.
+ */
+typedef struct {
+    u64    key;          // Program hash mixed with backend id
+    void*  data;
+    size_t size;
+} sf_bake_entry;
+
+/**
+ * @brief Content hash registered for a loaded program.
+ */
+typedef struct {
+    const sf_program* program;
+    u64               hash;
+    void*             block;   // Owned backing (malloc) of an adopted program, NULL if in the arena
+} sf_program_key;
+
 /**
  * @brief The Core Engine Structure.
  */
 struct sf_engine {
-    // Memory Management
+    // Memory Management (reserved address space, pages committed on first touch)
     sf_arena arena;           // Static memory (Code, Metadata)
     void*    arena_buffer;
+    size_t   arena_reserved;
     sf_heap  heap;            // Dynamic memory (Tensors, Data)
     void*    heap_buffer;
+    size_t   heap_reserved;
+    bool     release_on_reset;
+    sf_engine_allocator allocator; // Tracks heap usage; use sf_engine_alloc(engine)
+    size_t   arena_peak;
+
+    // Pipeline metadata (resource/kernel arrays, names, bindings, register tables).
+    // Lives in the arena after a bind; each hot reload builds it in a fresh heap block
+    // and releases the previous one, so live editing does not grow the arena.
+    sf_arena* meta_arena;     // &arena, or &reload_arena
+    sf_arena  reload_arena;
+    void*     reload_block;   // Backing of reload_arena (engine allocator)
 
     // Backend Implementation
     sf_backend backend;
+    u32        setup_threads; // Workers used for baking during bind (1 = serial)
+
+    // Bake Cache (heap-independent, survives sf_engine_reset)
+    sf_bake_codec  bake_codec;     // backend_id points at bake_backend_id
+    char*          bake_backend_id;
+    char*          bake_cache_dir;
+    sf_bake_entry* bake_entries;
+    u32            bake_entry_count;
+    u32            bake_entry_cap;
+    sf_program_key* program_keys;
+    u32             program_key_count;
+    u32             program_key_cap;
 
     // Pipeline State
     sf_resource_inst* resources;
@@ -65,21 +140,192 @@ struct sf_engine {
     // Buffer Synchronization
     u8 front_idx;             // Index for Read
     u8 back_idx;              // Index for Write
+
+    // Batched mode: resources hold batch_size instances (size_bytes covers all of them)
+    u32  batch_size;          // >= 1
+
+    // Dirty row band for the next dispatch (rows of screen-size resources)
+    bool roi_pending;
+    i32  roi_y0, roi_y1;
     
     // Status
     sf_atomic_i32 error_code; // Global Kill Switch (Atomic)
 
     // Stats
     uint64_t frame_index;
+    struct sf_perf_ctx* perf; // Optional kernel profiling (sf_perf.c)
+
+    // Copy-on-write cloning (sf_engine_clone.c)
+    sf_atomic_i32         refs;            // Caller handle + live clones
+    struct sf_engine*    clone_template;  // Clones: engine owning the shared programs/bakes (ref held)
+    struct sf_cow_image* cow_source;      // Clones: shared resource data (ref held)
+    struct sf_cow_image* cow_cache;       // Sources: capture of the current state, reused by clones
+    struct sf_cow_image* rewind_point;    // Contents sf_engine_rewind restores (ref held, shared with clones)
+
+    // File-mapped resources (sf_resource_map.c)
+    bool map_prefetch;        // Some resource asks for prefetch ahead of its readers
 };
 
 // --- Internal Utilities (Shared across module files) ---
 
 /**
- * @brief Resets/Initializes the internal state for a kernel program.
+ * @brief Gives a clone private storage for buffers[b] before it is written.
+ * copy keeps the shared contents (false when the caller overwrites everything).
+ * Defined in sf_engine_clone.c.
+ */
+bool sf_engine_cow_own(sf_engine* engine, sf_resource_inst* res, int b, bool copy);
+
+static inline bool sf_engine_cow_write(sf_engine* engine, sf_resource_inst* res, int b, bool copy) {
+    return !(res->cow_mask & (1u << b)) || sf_engine_cow_own(engine, res, b, copy);
+}
+
+/**
+ * @brief Drops the state capture cached for cloning once the source's state changes.
+ */
+void sf_engine_cow_invalidate(sf_engine* engine);
+
+/**
+ * @brief Forgets borrowed buffers and releases the clone's image and template (on reset).
+ */
+void sf_engine_cow_detach(sf_engine* engine);
+
+/**
+ * @brief Saved contents of resource res_idx at the rewind point, or NULL if there is none
+ * (no rewind point, or the resource was resized since).
+ */
+const void* sf_engine_rewind_data(const sf_engine* engine, u32 res_idx);
+
+/**
+ * @brief Forgets the rewind point (its resource table no longer matches after a reload).
+ */
+void sf_engine_drop_rewind_point(sf_engine* engine);
+
+/**
+ * @brief Backs a resource with its file (single buffer, no heap). Defined in sf_resource_map.c.
+ */
+bool sf_engine_map_file(sf_engine* engine, sf_resource_inst* res);
+
+/**
+ * @brief Fails (and logs) if a read-only mapped resource is bound as a kernel output.
+ * Run against the current bindings whenever they change (bind and hot reload).
+ */
+bool sf_engine_check_mapped_writes(const sf_engine* engine, const sf_resource_inst* res);
+
+/**
+ * @brief Unmaps a file-backed resource's buffer (dirty pages still reach the file).
+ */
+void sf_engine_unmap_file(sf_resource_inst* res);
+
+/**
+ * @brief Starts reading in the file-backed resources kernel k_idx reads (prefetch only).
+ */
+void sf_engine_prefetch_kernel(sf_engine* engine, u32 k_idx);
+
+/**
+ * @brief (Re)initializes the engine allocator over a freshly initialized heap.
+ * Defined in sf_engine_alloc.c.
+ */
+void sf_engine_allocator_init(sf_engine_allocator* a, sf_heap* heap);
+
+/**
+ * @brief Sets how large buffers are backed (dedicated huge-page mappings, NUMA placement).
+ */
+void sf_engine_allocator_configure(sf_engine_allocator* a, int large_pages, size_t large_threshold, u64 numa_nodes);
+
+/**
+ * @brief Returns all cached free blocks to the heap.
+ */
+void sf_engine_allocator_trim(sf_engine_allocator* a);
+
+/**
+ * @brief Usable capacity of a block returned by the engine allocator (0 if foreign).
+ */
+size_t sf_engine_allocator_capacity(const void* ptr);
+
+/**
+ * @brief Largest single block the heap can currently provide (probing, not for hot paths).
+ */
+size_t sf_engine_allocator_largest_free(sf_engine_allocator* a, size_t upper_bound);
+
+static inline size_t sf_engine_instance_bytes(const sf_engine* engine, const sf_resource_inst* res) {
+    return res->size_bytes / engine->batch_size;
+}
+
+static inline sf_allocator* sf_engine_alloc(sf_engine* engine) {
+    return &engine->allocator.base;
+}
+
+/**
+ * @brief Records the arena high-water mark. Defined in sf_memory_stats.c.
+ */
+void sf_engine_track_arena(sf_engine* engine);
+
+/**
+ * @brief Resets/Initializes the internal state (registers) for a kernel program.
+ * Equivalent to sf_state_reserve followed by sf_state_init_registers.
  * Defined in sf_engine.c, used in sf_pipeline.c.
  */
-void sf_state_reset(sf_state* state, const sf_program* prog, sf_arena* arena, sf_backend* backend);
+void sf_state_reset(sf_state* state, const sf_program* prog, sf_arena* arena);
+
+/**
+ * @brief Allocation half of sf_state_reset: register tables from the arena and static
+ * registers from the state allocator. Not thread-safe (arena and heap are shared).
+ */
+bool sf_state_reserve(sf_state* state, const sf_program* prog, sf_arena* arena);
+
+/**
+ * @brief Moves a state's register tables into arena (the previous copy is left unused).
+ */
+bool sf_state_relocate(sf_state* state, sf_arena* arena);
+
+/**
+ * @brief Arena bytes sf_state_reserve takes for a program's register tables (without alignment).
+ */
+size_t sf_state_table_size(const sf_program* prog);
+
+/**
+ * @brief Fills register metadata and zeroes owned registers. Touches only this state,
+ * so kernels can be initialized concurrently once reserved.
+ */
+void sf_state_init_registers(sf_state* state, const sf_program* prog);
+
+/**
+ * @brief Releases a kernel's owned registers and baked data.
+ */
+void sf_state_shutdown(sf_state* state, sf_backend* backend);
+
+/**
+ * @brief Bakes bound kernels through the backend, reusing cached results when possible.
+ * mask selects kernels to bake (NULL = all). Runs on engine->setup_threads workers.
+ * Defined in sf_bake_cache.c.
+ */
+void sf_engine_bake_kernels(sf_engine* engine, const bool* mask);
+
+/**
+ * @brief Moves a fully written tmp_path over path, replacing any existing file atomically.
+ */
+bool sf_engine_replace_file(const char* tmp_path, const char* path);
+
+/**
+ * @brief Drops program registrations no bound kernel uses any more (after a hot reload)
+ * and frees the blocks of adopted ones.
+ */
+void sf_engine_prune_programs(sf_engine* engine);
+
+/**
+ * @brief Drops every program registration and frees adopted program blocks (reset/shutdown).
+ */
+void sf_engine_release_programs(sf_engine* engine);
+
+/**
+ * @brief Returns the registered content hash of a program (0 if unknown).
+ */
+u64 sf_engine_program_hash(sf_engine* engine, const sf_program* prog);
+
+/**
+ * @brief Releases all cached bake blobs and program registrations.
+ */
+void sf_bake_cache_shutdown(sf_engine* engine);
 
 /**
  * @brief Finds resource index by its name hash.
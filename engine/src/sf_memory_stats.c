@@ -0,0 +1,80 @@
+#include <sionflow/engine/sf_engine.h>
+#include "sf_engine_internal.h"
+#include <sionflow/base/sf_shape.h>
+#include <string.h>
+
+static size_t _arena_used(const sf_engine* engine) {
+    return engine->arena.pos;
+}
+
+void sf_engine_track_arena(sf_engine* engine) {
+    size_t used = _arena_used(engine);
+    if (used > engine->arena_peak) engine->arena_peak = used;
+}
+
+static size_t _resource_bytes(const sf_resource_inst* res) {
+    if (!res->buffers[0]) return 0;
+    return (res->buffers[0] == res->buffers[1]) ? res->size_bytes : res->size_bytes * 2;
+}
+
+static size_t _register_bytes(const sf_kernel_inst* ker) {
+    const sf_state* st = &ker->state;
+    if (!st->ownership_flags || !st->reg_data) return 0;
+    size_t total = 0;
+    for (u32 i = 0; i < st->register_count; ++i) {
+        if (!st->ownership_flags[i] || !st->reg_data[i]) continue;
+        total += sf_shape_calc_bytes((sf_dtype)st->reg_dtypes[i], &st->reg_shapes[i * SF_MAX_DIMS], st->reg_ndims[i]);
+    }
+    return total;
+}
+
+bool sf_engine_get_memory_stats(sf_engine* engine, sf_engine_memory_stats* out) {
+    if (!engine || !out) return false;
+    memset(out, 0, sizeof(sf_engine_memory_stats));
+    sf_engine_track_arena(engine);
+
+    out->arena_limit = engine->arena_reserved;
+    out->arena_used = _arena_used(engine);
+    out->arena_peak = engine->arena_peak;
+
+    sf_engine_allocator* a = &engine->allocator;
+    out->heap_limit = engine->heap_reserved;
+    out->heap_used = a->used;
+    out->heap_cached = a->cached;
+    out->heap_peak = a->peak;
+    out->allocation_count = a->alloc_count;
+
+    size_t free_bytes = (out->heap_limit > a->used + a->cached) ? out->heap_limit - a->used - a->cached : 0;
+    out->heap_largest_free = sf_engine_allocator_largest_free(a, free_bytes);
+    out->heap_fragmentation = (free_bytes > 0) ? 1.0f - (float)out->heap_largest_free / (float)free_bytes : 0.0f;
+    if (out->heap_fragmentation < 0.0f) out->heap_fragmentation = 0.0f;
+
+    for (u32 i = 0; i < engine->resource_count; ++i) out->resource_bytes += _resource_bytes(&engine->resources[i]);
+    for (u32 k = 0; k < engine->kernel_count; ++k) {
+        out->register_bytes += _register_bytes(&engine->kernels[k]);
+        out->baked_bytes += engine->kernels[k].baked_size;
+    }
+    return true;
+}
+
+void sf_engine_iterate_memory(sf_engine* engine, sf_engine_memory_cb cb, void* user_data) {
+    if (!engine || !cb) return;
+    for (u32 i = 0; i < engine->resource_count; ++i) {
+        sf_resource_inst* res = &engine->resources[i];
+        sf_engine_memory_entry e = {
+            .name = res->name, .is_kernel = false,
+            .bytes = _resource_bytes(res),
+            .buffer_count = (u8)(!res->buffers[0] ? 0 : (res->buffers[0] == res->buffers[1] ? 1 : 2))
+        };
+        cb(&e, user_data);
+    }
+    for (u32 k = 0; k < engine->kernel_count; ++k) {
+        sf_kernel_inst* ker = &engine->kernels[k];
+        sf_engine_memory_entry e = {
+            .name = ker->id, .is_kernel = true,
+            .bytes = _register_bytes(ker),
+            .baked_bytes = ker->baked_size
+        };
+        cb(&e, user_data);
+    }
+}
@@ -0,0 +1,298 @@
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
+#include "sf_perf.h"
+#include <sionflow/engine/sf_engine.h>
+#include <sionflow/engine/sf_thread.h>
+#include "sf_engine_internal.h"
+#include <sionflow/base/sf_log.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <dirent.h>
+#define SF_PERF_HW_COUNTERS 1
+#endif
+
+#define SF_PERF_MAX_THREADS 256
+
+typedef struct {
+    u64 invocations;
+    u64 time_ns;
+    u64 values[SF_PERF_COUNTER_COUNT];
+} sf_perf_stat;
+
+typedef struct {
+    u32           id_hash;  // Kernel the slot belongs to (slots are reused after rebinds)
+    sf_perf_stat  total;
+    sf_perf_stat* tasks;
+    u32           task_cap;
+} sf_perf_kernel;
+
+struct sf_perf_ctx {
+    bool            per_task;
+    bool            counters_valid;
+    int             leaders[SF_PERF_MAX_THREADS];
+    int             members[SF_PERF_MAX_THREADS][SF_PERF_COUNTER_COUNT - 1];
+    i32             tids[SF_PERF_MAX_THREADS];
+    u32             thread_count;
+    i32             dispatch_tid; // Last thread seen sampling (always counted)
+    sf_perf_kernel* kernels;
+    u32             kernel_cap;
+};
+
+static u64 _now_ns(void) {
+    struct timespec ts;
+#ifdef _WIN32
+    timespec_get(&ts, TIME_UTC);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+    return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+}
+
+// --- Hardware Counters ---
+
+#ifdef SF_PERF_HW_COUNTERS
+
+static const struct { u32 type; u64 config; } SF_PERF_EVENTS[SF_PERF_COUNTER_COUNT] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },   // Last level cache on most PMUs
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+};
+
+static int _perf_open(u32 event, pid_t tid, int group_fd) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = SF_PERF_EVENTS[event].type;
+    attr.config = SF_PERF_EVENTS[event].config;
+    attr.disabled = (group_fd == -1);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return (int)syscall(SYS_perf_event_open, &attr, tid, -1, group_fd, 0);
+}
+
+static void _close_counters(struct sf_perf_ctx* perf) {
+    for (u32 t = 0; t < perf->thread_count; ++t) {
+        for (u32 m = 0; m < SF_PERF_COUNTER_COUNT - 1; ++m) if (perf->members[t][m] >= 0) close(perf->members[t][m]);
+        if (perf->leaders[t] >= 0) close(perf->leaders[t]);
+    }
+    perf->thread_count = 0;
+    perf->counters_valid = false;
+}
+
+static bool _open_thread(struct sf_perf_ctx* perf, pid_t tid) {
+    u32 t = perf->thread_count;
+    perf->leaders[t] = _perf_open(0, tid, -1);
+    if (perf->leaders[t] < 0) return false;
+    for (u32 m = 0; m < SF_PERF_COUNTER_COUNT - 1; ++m) {
+        perf->members[t][m] = _perf_open(m + 1, tid, perf->leaders[t]);
+        if (perf->members[t][m] < 0) {
+            for (u32 j = 0; j < m; ++j) close(perf->members[t][j]);
+            close(perf->leaders[t]);
+            return false;
+        }
+    }
+    ioctl(perf->leaders[t], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(perf->leaders[t], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    perf->tids[t] = (i32)tid;
+    perf->thread_count++;
+    return true;
+}
+
+static _Thread_local pid_t t_tid;
+
+static pid_t _self_tid(void) {
+    if (!t_tid) t_tid = (pid_t)syscall(SYS_gettid);
+    return t_tid;
+}
+
+/**
+ * Opens a counter group for the calling thread and for every thread that may run
+ * backend work, so what workers do on behalf of a kernel is charged to it as well.
+ * The process main thread (an event loop when it isn't the caller) and helper threads
+ * from sf_thread_start (sim, render and service workers, log flusher) are left out:
+ * they only add noise, and every sample costs one read() per counted thread.
+ * A helper that dispatches is picked up on its first sample (sf_perf_read).
+ */
+static void _open_counters(struct sf_perf_ctx* perf) {
+    _close_counters(perf);
+    DIR* dir = opendir("/proc/self/task");
+    if (!dir) return;
+
+    pid_t self = _self_tid();
+    pid_t main_tid = getpid();
+    bool any_failed = false;
+    struct dirent* ent;
+    while ((ent = readdir(dir)) != NULL && perf->thread_count < SF_PERF_MAX_THREADS) {
+        if (ent->d_name[0] < '0' || ent->d_name[0] > '9') continue;
+        pid_t tid = (pid_t)atoi(ent->d_name);
+        if (tid != self && (tid == main_tid || sf_thread_is_helper(tid))) continue;
+        if (!_open_thread(perf, tid)) any_failed = true;
+    }
+    closedir(dir);
+    perf->dispatch_tid = (i32)self;
+
+    perf->counters_valid = perf->thread_count > 0;
+    if (!perf->counters_valid) {
+        SF_LOG_WARN("Engine: Hardware counters unavailable (check perf_event_paranoid). Profiling wall time only.");
+    } else if (any_failed) {
+        SF_LOG_WARN("Engine: Hardware counters opened on %u threads only; totals are partial.", perf->thread_count);
+    }
+}
+
+static void _read_counters(struct sf_perf_ctx* perf, u64* values) {
+    // Dispatch moved to another thread (e.g. a render worker): count it from now on
+    pid_t self = _self_tid();
+    if ((i32)self != perf->dispatch_tid) {
+        bool known = false;
+        for (u32 t = 0; t < perf->thread_count && !known; ++t) known = perf->tids[t] == (i32)self;
+        if (!known && perf->thread_count < SF_PERF_MAX_THREADS) _open_thread(perf, self);
+        perf->dispatch_tid = (i32)self;
+    }
+
+    memset(values, 0, sizeof(u64) * SF_PERF_COUNTER_COUNT);
+    u64 buf[1 + SF_PERF_COUNTER_COUNT];
+    for (u32 t = 0; t < perf->thread_count; ++t) {
+        if (read(perf->leaders[t], buf, sizeof(buf)) != (ssize_t)sizeof(buf) || buf[0] != SF_PERF_COUNTER_COUNT) continue;
+        for (u32 c = 0; c < SF_PERF_COUNTER_COUNT; ++c) values[c] += buf[1 + c];
+    }
+}
+
+#else
+
+static void _close_counters(struct sf_perf_ctx* perf) { perf->counters_valid = false; }
+static void _open_counters(struct sf_perf_ctx* perf) { perf->counters_valid = false; }
+static void _read_counters(struct sf_perf_ctx* perf, u64* values) { (void)perf; memset(values, 0, sizeof(u64) * SF_PERF_COUNTER_COUNT); }
+
+#endif
+
+// --- Dispatch Hooks ---
+
+void sf_perf_read(struct sf_perf_ctx* perf, sf_perf_sample* out) {
+    if (perf->counters_valid) _read_counters(perf, out->values);
+    else memset(out->values, 0, sizeof(out->values));
+    out->time_ns = _now_ns();
+}
+
+bool sf_perf_per_task(const struct sf_perf_ctx* perf) {
+    return perf->per_task;
+}
+
+static void _add(sf_perf_stat* st, const sf_perf_sample* start, const sf_perf_sample* end) {
+    st->invocations++;
+    st->time_ns += end->time_ns - start->time_ns;
+    for (u32 c = 0; c < SF_PERF_COUNTER_COUNT; ++c) st->values[c] += end->values[c] - start->values[c];
+}
+
+static sf_perf_kernel* _kernel_slot(struct sf_perf_ctx* perf, u32 kernel_idx, u32 kernel_hash) {
+    if (kernel_idx >= perf->kernel_cap) {
+        u32 new_cap = kernel_idx + 16;
+        sf_perf_kernel* k = realloc(perf->kernels, sizeof(sf_perf_kernel) * new_cap);
+        if (!k) return NULL;
+        memset(k + perf->kernel_cap, 0, sizeof(sf_perf_kernel) * (new_cap - perf->kernel_cap));
+        perf->kernels = k;
+        perf->kernel_cap = new_cap;
+    }
+    sf_perf_kernel* slot = &perf->kernels[kernel_idx];
+    if (slot->id_hash != kernel_hash) {
+        // A different kernel now occupies this index: start over
+        memset(&slot->total, 0, sizeof(sf_perf_stat));
+        if (slot->tasks) memset(slot->tasks, 0, sizeof(sf_perf_stat) * slot->task_cap);
+        slot->id_hash = kernel_hash;
+    }
+    return slot;
+}
+
+void sf_perf_accumulate(struct sf_perf_ctx* perf, u32 kernel_idx, u32 kernel_hash, i32 task_index, const sf_perf_sample* start) {
+    sf_perf_sample end;
+    sf_perf_read(perf, &end);
+
+    sf_perf_kernel* slot = _kernel_slot(perf, kernel_idx, kernel_hash);
+    if (!slot) return;
+    if (task_index < 0) {
+        _add(&slot->total, start, &end);
+        return;
+    }
+    if ((u32)task_index >= slot->task_cap) {
+        u32 new_cap = (u32)task_index + 8;
+        sf_perf_stat* tasks = realloc(slot->tasks, sizeof(sf_perf_stat) * new_cap);
+        if (!tasks) return;
+        memset(tasks + slot->task_cap, 0, sizeof(sf_perf_stat) * (new_cap - slot->task_cap));
+        slot->tasks = tasks;
+        slot->task_cap = new_cap;
+    }
+    _add(&slot->tasks[task_index], start, &end);
+}
+
+// --- Public API ---
+
+bool sf_engine_enable_profiling(sf_engine* engine, bool per_task) {
+    if (!engine) return false;
+    if (!engine->perf) {
+        engine->perf = calloc(1, sizeof(struct sf_perf_ctx));
+        if (!engine->perf) return false;
+    }
+    engine->perf->per_task = per_task;
+    _open_counters(engine->perf);
+    return engine->perf->counters_valid;
+}
+
+void sf_engine_disable_profiling(sf_engine* engine) {
+    if (!engine || !engine->perf) return;
+    struct sf_perf_ctx* perf = engine->perf;
+    _close_counters(perf);
+    for (u32 k = 0; k < perf->kernel_cap; ++k) free(perf->kernels[k].tasks);
+    free(perf->kernels);
+    free(perf);
+    engine->perf = NULL;
+}
+
+void sf_engine_reset_profiling(sf_engine* engine) {
+    if (!engine || !engine->perf) return;
+    struct sf_perf_ctx* perf = engine->perf;
+    for (u32 k = 0; k < perf->kernel_cap; ++k) {
+        memset(&perf->kernels[k].total, 0, sizeof(sf_perf_stat));
+        if (perf->kernels[k].tasks) memset(perf->kernels[k].tasks, 0, sizeof(sf_perf_stat) * perf->kernels[k].task_cap);
+    }
+    _open_counters(perf);
+}
+
+static void _emit(const sf_perf_stat* st, const char* id, i32 task_index, bool valid, sf_engine_counters_cb cb, void* user_data) {
+    sf_engine_kernel_counters e;
+    memset(&e, 0, sizeof(e));
+    e.kernel_id = id;
+    e.task_index = task_index;
+    e.invocations = st->invocations;
+    e.time_ns = st->time_ns;
+    e.counters_valid = valid;
+    e.cycles = st->values[0];
+    e.instructions = st->values[1];
+    e.llc_misses = st->values[2];
+    e.branch_misses = st->values[3];
+    cb(&e, user_data);
+}
+
+void sf_engine_iterate_counters(sf_engine* engine, sf_engine_counters_cb cb, void* user_data) {
+    if (!engine || !engine->perf || !cb) return;
+    struct sf_perf_ctx* perf = engine->perf;
+    for (u32 k = 0; k < engine->kernel_count && k < perf->kernel_cap; ++k) {
+        const sf_kernel_inst* ker = &engine->kernels[k];
+        const sf_perf_kernel* slot = &perf->kernels[k];
+        if (slot->id_hash != ker->id_hash || slot->total.invocations == 0) continue;
+
+        _emit(&slot->total, ker->id, -1, perf->counters_valid, cb, user_data);
+        for (u32 t = 0; t < slot->task_cap; ++t) {
+            if (slot->tasks[t].invocations) _emit(&slot->tasks[t], ker->id, (i32)t, perf->counters_valid, cb, user_data);
+        }
+    }
+}
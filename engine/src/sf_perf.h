@@ -0,0 +1,25 @@
+#ifndef SF_PERF_H
+#define SF_PERF_H
+
+#include <sionflow/base/sf_types.h>
+
+/**
+ * Kernel profiling hooks used by sf_engine_dispatch.
+ * A sample is a point-in-time reading (monotonic time + summed hardware counters);
+ * accumulating charges the delta since a sample to a kernel or task.
+ */
+
+#define SF_PERF_COUNTER_COUNT 4 // cycles, instructions, LLC misses, branch misses
+
+struct sf_perf_ctx;
+
+typedef struct {
+    u64 time_ns;
+    u64 values[SF_PERF_COUNTER_COUNT];
+} sf_perf_sample;
+
+void    sf_perf_read(struct sf_perf_ctx* perf, sf_perf_sample* out);
+void    sf_perf_accumulate(struct sf_perf_ctx* perf, u32 kernel_idx, u32 kernel_hash, i32 task_index, const sf_perf_sample* start);
+bool    sf_perf_per_task(const struct sf_perf_ctx* perf);
+
+#endif // SF_PERF_H
@@ -1,4 +1,5 @@
 #include <sionflow/engine/sf_engine.h>
+#include <sionflow/engine/sf_thread.h>
 #include "sf_engine_internal.h"
 #include <sionflow/base/sf_log.h>
 #include <sionflow/base/sf_utils.h>
@@ -43,7 +44,7 @@ int32_t find_symbol_idx(const sf_program* prog, u32 name_hash) {
 
 // --- Internal Engine Logic ---
 
-static void _setup_resource_inst(sf_resource_inst* res, const char* name, sf_dtype dtype, const int32_t* shape, uint8_t ndim, uint8_t flags, sf_arena* arena) {
+static void _setup_resource_inst(sf_resource_inst* res, const char* name, sf_dtype dtype, const int32_t* shape, uint8_t ndim, uint8_t flags, u32 batch, sf_arena* arena) {
     res->name = sf_arena_strdup(arena, name);
     res->name_hash = sf_fnv1a_hash(res->name);
     res->flags = flags;
@@ -53,9 +54,19 @@ static void _setup_resource_inst(sf_resource_inst* res, const char* name, sf_dty
     res->desc.info.ndim = ndim;
     if (ndim > 0 && shape) memcpy(res->desc.info.shape, shape, sizeof(int32_t) * ndim);
     sf_shape_calc_strides(&res->desc.info);
+    res->decl_info = res->desc.info;
     
-    res->size_bytes = sf_tensor_size_bytes(&res->desc);
+    res->size_bytes = sf_tensor_size_bytes(&res->desc) * batch;
     res->buffers[0] = res->buffers[1] = NULL;
+    res->map_flags = 0;
+    res->map_path = NULL;
+    res->reload_kept = false;
+}
+
+static void _setup_resource_map(sf_resource_inst* res, const sf_pipeline_resource* d, sf_arena* arena) {
+    if (!(d->map_flags & (SF_RESOURCE_MAP_READ | SF_RESOURCE_MAP_WRITE)) || !d->map_path) return;
+    res->map_flags = d->map_flags;
+    res->map_path = sf_arena_strdup(arena, d->map_path);
 }
 
 static void analyze_transience(sf_engine* engine) {
@@ -81,48 +92,62 @@ static void analyze_transience(sf_engine* engine) {
     }
 }
 
-static void allocate_resources(sf_engine* engine) {
-    sf_allocator* alloc = (sf_allocator*)&engine->heap;
-    for (u32 i = 0; i < engine->resource_count; ++i) {
-        sf_resource_inst* res = &engine->resources[i];
-        bool trans = (res->flags & SF_RESOURCE_FLAG_TRANSIENT) != 0;
-        
-        if (res->size_bytes == 0 && res->desc.info.ndim > 0) {
-            res->size_bytes = sf_tensor_size_bytes(&res->desc);
-        }
+static bool _allocate_resource(sf_engine* engine, sf_resource_inst* res) {
+    sf_allocator* alloc = sf_engine_alloc(engine);
+    bool trans = (res->flags & SF_RESOURCE_FLAG_TRANSIENT) != 0;
 
-        res->buffers[0] = SF_ARENA_PUSH(&engine->arena, sf_buffer, 1);
-        if (res->size_bytes > 0) {
-            sf_buffer_alloc(res->buffers[0], alloc, res->size_bytes);
-        } else {
-            memset(res->buffers[0], 0, sizeof(sf_buffer));
-        }
+    if (res->size_bytes == 0 && res->desc.info.ndim > 0) {
+        res->size_bytes = sf_tensor_size_bytes(&res->desc) * engine->batch_size;
+    }
+    if (res->map_flags) return sf_engine_map_file(engine, res);
 
-        if (trans) {
-            res->buffers[1] = res->buffers[0];
-        } else {
-            res->buffers[1] = SF_ARENA_PUSH(&engine->arena, sf_buffer, 1);
-            if (res->size_bytes > 0) {
-                sf_buffer_alloc(res->buffers[1], alloc, res->size_bytes);
-            } else {
-                memset(res->buffers[1], 0, sizeof(sf_buffer));
-            }
+    for (int b = 0; b < (trans ? 1 : 2); ++b) {
+        res->buffers[b] = SF_ARENA_PUSH(engine->meta_arena, sf_buffer, 1);
+        if (!res->buffers[b]) return false;
+        memset(res->buffers[b], 0, sizeof(sf_buffer));
+        if (res->size_bytes > 0 && !sf_buffer_alloc(res->buffers[b], alloc, res->size_bytes)) return false;
+    }
+    if (trans) res->buffers[1] = res->buffers[0];
+    return true;
+}
+
+static void _free_resource(sf_resource_inst* res) {
+    if (res->map_flags) {
+        sf_engine_unmap_file(res);
+        return;
+    }
+    if (res->buffers[0] && res->buffers[0]->data) sf_buffer_free(res->buffers[0]);
+    if (res->buffers[1] && res->buffers[1] != res->buffers[0] && res->buffers[1]->data) sf_buffer_free(res->buffers[1]);
+    res->buffers[0] = res->buffers[1] = NULL;
+}
+
+static void allocate_resources(sf_engine* engine) {
+    for (u32 i = 0; i < engine->resource_count; ++i) {
+        if (!_allocate_resource(engine, &engine->resources[i])) {
+            SF_LOG_ERROR("Engine: Failed to allocate resource '%s'.", engine->resources[i].name);
         }
     }
 }
 
-static void apply_initial_data(sf_engine* engine) {
+// fresh_res: per-resource mask of newly allocated resources (NULL = all)
+static void apply_initial_data(sf_engine* engine, const bool* fresh_res) {
     for (u32 k = 0; k < engine->kernel_count; ++k) {
         sf_kernel_inst* ker = &engine->kernels[k];
         for (u32 b = 0; b < ker->binding_count; ++b) {
             sf_kernel_binding* bind = &ker->bindings[b];
+            if (fresh_res && !fresh_res[bind->global_res]) continue;
             void* data = ker->program->tensor_data[bind->local_reg];
-            if (data) {
+            // A mapped resource's file is its initial data
+            if (data && !engine->resources[bind->global_res].map_flags) {
                 sf_resource_inst* res = &engine->resources[bind->global_res];
-                if (res->size_bytes > 0 && res->buffers[0]->data) {
-                    memcpy(res->buffers[0]->data, data, res->size_bytes);
-                    if (res->buffers[1] != res->buffers[0]) {
-                        memcpy(res->buffers[1]->data, data, res->size_bytes);
+                size_t bytes = sf_engine_instance_bytes(engine, res);
+                if (bytes > 0 && res->buffers[0] && res->buffers[0]->data) {
+                    // Every batch instance starts from the same data
+                    for (u32 inst = 0; inst < engine->batch_size; ++inst) {
+                        memcpy((u8*)res->buffers[0]->data + inst * bytes, data, bytes);
+                        if (res->buffers[1] != res->buffers[0]) {
+                            memcpy((u8*)res->buffers[1]->data + inst * bytes, data, bytes);
+                        }
                     }
                 }
             }
@@ -130,14 +155,79 @@ static void apply_initial_data(sf_engine* engine) {
     }
 }
 
+static void _init_kernel_registers(void* ctx, u32 index) {
+    sf_engine* engine = (sf_engine*)ctx;
+    sf_state_init_registers(&engine->kernels[index].state, engine->kernels[index].program);
+}
+
 static void sf_engine_finalize_setup(sf_engine* engine) {
     analyze_transience(engine);
     allocate_resources(engine);
-    apply_initial_data(engine);
+    apply_initial_data(engine, NULL);
 
+    // Arena/heap are single-threaded: register memory is reserved serially, then
+    // register initialization and baking fan out over the setup workers
     for (u32 k = 0; k < engine->kernel_count; ++k) {
-        sf_state_reset(&engine->kernels[k].state, engine->kernels[k].program, &engine->arena, &engine->backend);
+        sf_state_reserve(&engine->kernels[k].state, engine->kernels[k].program, engine->meta_arena);
     }
+    sf_parallel_for(engine->kernel_count, engine->setup_threads ? engine->setup_threads : 1, _init_kernel_registers, engine);
+    sf_engine_bake_kernels(engine, NULL);
+    sf_engine_track_arena(engine);
+}
+
+static sf_kernel_binding* _push_binding(sf_kernel_inst* k, const sf_bin_symbol* sym, int32_t r_idx) {
+    sf_kernel_binding* kb = &k->bindings[k->binding_count++];
+    kb->local_reg = (u16)sym->register_idx;
+    kb->global_res = (u16)r_idx;
+    kb->flags = sym->flags;
+    return kb;
+}
+
+/**
+ * Resolves explicit pipeline bindings, then auto-binds remaining I/O symbols by name.
+ */
+static bool _bind_kernel_ports(sf_engine* engine, sf_kernel_inst* k, const sf_pipeline_kernel* d) {
+    k->bindings = SF_ARENA_PUSH(engine->meta_arena, sf_kernel_binding, d->binding_count + k->program->meta.symbol_count);
+    k->binding_count = 0;
+    if (!k->bindings && d->binding_count + k->program->meta.symbol_count > 0) {
+        SF_LOG_ERROR("Pipeline: Arena OOM while binding kernel '%s'", k->id);
+        return false;
+    }
+
+    for (u32 b = 0; b < d->binding_count; ++b) {
+        int32_t s_idx = find_symbol_idx(k->program, sf_fnv1a_hash(d->bindings[b].kernel_port));
+        int32_t r_idx = find_resource_idx(engine, sf_fnv1a_hash(d->bindings[b].global_resource));
+        if (s_idx != -1 && r_idx != -1) {
+            sf_bin_symbol* sym = &k->program->symbols[s_idx];
+            sf_type_info* t_info = &k->program->tensor_infos[sym->register_idx];
+            if (!_check_resource_compatibility(&engine->resources[r_idx], t_info->dtype, t_info->shape, t_info->ndim)) {
+                SF_LOG_FATAL("Pipeline: Kernel '%s' port '%s' is incompatible with resource '%s'", k->id, d->bindings[b].kernel_port, d->bindings[b].global_resource);
+                return false;
+            }
+            _push_binding(k, sym, r_idx);
+        }
+    }
+    for (u32 s = 0; s < k->program->meta.symbol_count; ++s) {
+        sf_bin_symbol* sym = &k->program->symbols[s];
+        if (!(sym->flags & (SF_SYMBOL_FLAG_INPUT | SF_SYMBOL_FLAG_OUTPUT))) continue;
+        bool bound = false;
+        for (u32 b = 0; b < k->binding_count; ++b) if (k->bindings[b].local_reg == sym->register_idx) bound = true;
+        if (bound) continue;
+        int32_t r_idx = find_resource_idx(engine, sym->name_hash);
+        if (r_idx != -1) _push_binding(k, sym, r_idx);
+    }
+    return true;
+}
+
+static void _init_kernel_inst(sf_engine* engine, sf_kernel_inst* k, const sf_pipeline_kernel* d, sf_program* prog) {
+    memset(k, 0, sizeof(sf_kernel_inst));
+    k->id = sf_arena_strdup(engine->meta_arena, d->id);
+    k->id_hash = sf_fnv1a_hash(d->id);
+    k->program = prog;
+    k->program_hash = sf_engine_program_hash(engine, prog);
+    k->frequency = d->frequency;
+    k->flags = d->flags;
+    k->state.allocator = sf_engine_alloc(engine);
 }
 
 // --- Public API ---
@@ -149,7 +239,7 @@ void sf_engine_bind_cartridge(sf_engine* engine, sf_program** programs, const ch
     u32 total_syms = 0;
     for (u32 k = 0; k < count; ++k) total_syms += programs[k]->meta.symbol_count;
     
-    engine->resources = (total_syms > 0) ? SF_ARENA_PUSH(&engine->arena, sf_resource_inst, total_syms) : NULL;
+    engine->resources = (total_syms > 0) ? SF_ARENA_PUSH(engine->meta_arena, sf_resource_inst, total_syms) : NULL;
     engine->resource_count = 0;
 
     for (u32 k = 0; k < count; ++k) {
@@ -171,23 +261,24 @@ void sf_engine_bind_cartridge(sf_engine* engine, sf_program** programs, const ch
                 continue;
             }
 
-            _setup_resource_inst(&engine->resources[engine->resource_count++], sym->name, t->dtype, t->shape, t->ndim, sym->flags, &engine->arena);
+            _setup_resource_inst(&engine->resources[engine->resource_count++], sym->name, t->dtype, t->shape, t->ndim, sym->flags, engine->batch_size, engine->meta_arena);
         }
     }
 
     // 2. Init Kernels
-    engine->kernels = SF_ARENA_PUSH(&engine->arena, sf_kernel_inst, count);
+    engine->kernels = SF_ARENA_PUSH(engine->meta_arena, sf_kernel_inst, count);
     engine->kernel_count = count;
     for (u32 k = 0; k < count; ++k) {
         sf_program* prog = programs[k];
         sf_kernel_inst* inst = &engine->kernels[k];
-        inst->id = sf_arena_strdup(&engine->arena, (names && names[k]) ? names[k] : "kernel");
+        inst->id = sf_arena_strdup(engine->meta_arena, (names && names[k]) ? names[k] : "kernel");
         inst->id_hash = sf_fnv1a_hash(inst->id);
         inst->program = prog;
+        inst->program_hash = sf_engine_program_hash(engine, prog);
         inst->frequency = 1;
-        inst->state.allocator = (sf_allocator*)&engine->heap;
+        inst->state.allocator = sf_engine_alloc(engine);
         
-        inst->bindings = (prog->meta.symbol_count > 0) ? SF_ARENA_PUSH(&engine->arena, sf_kernel_binding, prog->meta.symbol_count) : NULL;
+        inst->bindings = (prog->meta.symbol_count > 0) ? SF_ARENA_PUSH(engine->meta_arena, sf_kernel_binding, prog->meta.symbol_count) : NULL;
         inst->binding_count = 0;
         for (u32 s = 0; s < prog->meta.symbol_count; ++s) {
             sf_bin_symbol* sym = &prog->symbols[s];
@@ -207,62 +298,337 @@ void sf_engine_bind_cartridge(sf_engine* engine, sf_program** programs, const ch
 
 void sf_engine_bind_pipeline(sf_engine* engine, const sf_pipeline_desc* pipe, sf_program** programs) {
     if (!engine || !pipe) return;
+    if ((u32)sf_atomic_load(&engine->refs) > 1 || engine->clone_template) {
+        SF_LOG_ERROR("Engine: Cannot bind a pipeline on an engine with live clones or on a clone.");
+        return;
+    }
 
     // 1. Init Resources from Desc
-    engine->resources = SF_ARENA_PUSH(&engine->arena, sf_resource_inst, pipe->resource_count);
+    engine->resources = SF_ARENA_PUSH(engine->meta_arena, sf_resource_inst, pipe->resource_count);
     engine->resource_count = pipe->resource_count;
     for (u32 i = 0; i < pipe->resource_count; ++i) {
         sf_pipeline_resource* d = &pipe->resources[i];
-        _setup_resource_inst(&engine->resources[i], d->name, d->dtype, d->shape, d->ndim, d->flags, &engine->arena);
+        _setup_resource_inst(&engine->resources[i], d->name, d->dtype, d->shape, d->ndim, d->flags, engine->batch_size, engine->meta_arena);
+        _setup_resource_map(&engine->resources[i], d, engine->meta_arena);
     }
 
     // 2. Init Kernels
-    engine->kernels = SF_ARENA_PUSH(&engine->arena, sf_kernel_inst, pipe->kernel_count);
+    engine->kernels = SF_ARENA_PUSH(engine->meta_arena, sf_kernel_inst, pipe->kernel_count);
     engine->kernel_count = pipe->kernel_count;
     for (u32 i = 0; i < pipe->kernel_count; ++i) {
-        sf_pipeline_kernel* d = &pipe->kernels[i];
         sf_kernel_inst* k = &engine->kernels[i];
-        k->id = sf_arena_strdup(&engine->arena, d->id);
-        k->id_hash = sf_fnv1a_hash(k->id);
-        k->program = programs[i];
-        k->frequency = d->frequency;
-        k->state.allocator = (sf_allocator*)&engine->heap;
-
-        k->bindings = SF_ARENA_PUSH(&engine->arena, sf_kernel_binding, d->binding_count + k->program->meta.symbol_count);
-        k->binding_count = 0;
-        for (u32 b = 0; b < d->binding_count; ++b) {
-            int32_t s_idx = find_symbol_idx(k->program, sf_fnv1a_hash(d->bindings[b].kernel_port));
-            int32_t r_idx = find_resource_idx(engine, sf_fnv1a_hash(d->bindings[b].global_resource));
-            if (s_idx != -1 && r_idx != -1) {
-                sf_bin_symbol* sym = &k->program->symbols[s_idx];
-                sf_type_info* t_info = &k->program->tensor_infos[sym->register_idx];
-                if (!_check_resource_compatibility(&engine->resources[r_idx], t_info->dtype, t_info->shape, t_info->ndim)) {
-                    SF_LOG_FATAL("Pipeline: Kernel '%s' port '%s' is incompatible with resource '%s'", k->id, d->bindings[b].kernel_port, d->bindings[b].global_resource);
-                    sf_atomic_store(&engine->error_code, SF_ENGINE_ERR_RUNTIME);
-                    return;
-                }
+        _init_kernel_inst(engine, k, &pipe->kernels[i], programs[i]);
+        if (!_bind_kernel_ports(engine, k, &pipe->kernels[i])) {
+            sf_atomic_store(&engine->error_code, SF_ENGINE_ERR_RUNTIME);
+            return;
+        }
+    }
 
-                sf_kernel_binding* kb = &k->bindings[k->binding_count++];
-                kb->local_reg = (u16)sym->register_idx;
-                kb->global_res = (u16)r_idx;
-                kb->flags = sym->flags;
+    sf_engine_finalize_setup(engine);
+}
+
+// --- Hot Reload ---
+
+sf_program* sf_engine_find_program(sf_engine* engine, uint64_t content_hash) {
+    if (!engine || content_hash == 0) return NULL;
+    for (u32 k = 0; k < engine->kernel_count; ++k) {
+        if (engine->kernels[k].program_hash == content_hash) return engine->kernels[k].program;
+    }
+    return NULL;
+}
+
+static bool _same_decl(const sf_resource_inst* a, const sf_resource_inst* b) {
+    if (a->decl_info.dtype != b->decl_info.dtype || a->decl_info.ndim != b->decl_info.ndim) return false;
+    if (a->map_flags != b->map_flags || (a->map_flags && strcmp(a->map_path, b->map_path) != 0)) return false;
+    return memcmp(a->decl_info.shape, b->decl_info.shape, sizeof(int32_t) * a->decl_info.ndim) == 0;
+}
+
+/**
+ * Moves a surviving resource's buffers into its new slot, adapting to a transience change.
+ * Buffer headers are copied into the new metadata; the data blocks do not move.
+ */
+static bool _adopt_resource(sf_engine* engine, sf_resource_inst* dst, sf_resource_inst* src) {
+    bool was_single = (src->buffers[0] == src->buffers[1]);
+    for (int b = 0; b < (was_single ? 1 : 2); ++b) {
+        dst->buffers[b] = NULL;
+        if (!src->buffers[b]) continue;
+        dst->buffers[b] = SF_ARENA_PUSH(engine->meta_arena, sf_buffer, 1);
+        if (!dst->buffers[b]) return false;
+        *dst->buffers[b] = *src->buffers[b];
+    }
+    if (was_single) dst->buffers[1] = dst->buffers[0];
+    dst->desc.info = src->desc.info; // Keep runtime resizes (screen size, assets)
+    dst->size_bytes = src->size_bytes;
+    dst->reload_kept = true;
+    if (dst->map_flags) {
+        src->buffers[0] = src->buffers[1] = NULL;
+        return true; // Always a single mapped buffer
+    }
+
+    bool is_single = (dst->flags & SF_RESOURCE_FLAG_TRANSIENT) != 0;
+    if (was_single && !is_single) {
+        sf_buffer* second = SF_ARENA_PUSH(engine->meta_arena, sf_buffer, 1);
+        if (!second) return false;
+        memset(second, 0, sizeof(sf_buffer));
+        if (dst->size_bytes > 0) {
+            if (!sf_buffer_alloc(second, sf_engine_alloc(engine), dst->size_bytes)) return false;
+            memcpy(second->data, dst->buffers[0]->data, dst->size_bytes);
+        }
+        dst->buffers[1] = second;
+    } else if (!was_single && is_single) {
+        u8 keep = engine->front_idx;
+        if (dst->buffers[1 - keep]->data) sf_buffer_free(dst->buffers[1 - keep]);
+        dst->buffers[1 - keep] = dst->buffers[keep];
+    }
+    src->buffers[0] = src->buffers[1] = NULL;
+    return true;
+}
+
+bool sf_engine_is_resource_kept(sf_engine* engine, const char* name) {
+    if (!engine || !name) return false;
+    int32_t idx = find_resource_idx(engine, sf_fnv1a_hash(name));
+    return idx != -1 && engine->resources[idx].reload_kept;
+}
+
+static size_t _strsize(const char* s) {
+    return s ? strlen(s) + 1 : 0;
+}
+
+// Upper bound of the metadata a reload pushes (arrays, names, buffer headers, bindings, register tables)
+static size_t _reload_meta_size(const sf_pipeline_desc* pipe, sf_program** programs) {
+    const size_t slack = SF_ENGINE_ALLOC_ALIGN; // Per push, for alignment
+    size_t bytes = sizeof(sf_resource_inst) * pipe->resource_count + sizeof(sf_kernel_inst) * pipe->kernel_count + 2 * slack;
+    for (u32 i = 0; i < pipe->resource_count; ++i) {
+        const sf_pipeline_resource* d = &pipe->resources[i];
+        bytes += _strsize(d->name) + _strsize(d->map_path) + 2 * sizeof(sf_buffer) + 4 * slack;
+    }
+    for (u32 i = 0; i < pipe->kernel_count; ++i) {
+        u32 bindings = pipe->kernels[i].binding_count + programs[i]->meta.symbol_count;
+        bytes += _strsize(pipe->kernels[i].id) + sizeof(sf_kernel_binding) * bindings + sf_state_table_size(programs[i]) + 3 * slack;
+    }
+    return bytes;
+}
+
+bool sf_engine_reload_pipeline(sf_engine* engine, const sf_pipeline_desc* pipe, sf_program** programs) {
+    if (!engine || !pipe || !programs) return false;
+    if ((u32)sf_atomic_load(&engine->refs) > 1 || engine->clone_template) {
+        SF_LOG_ERROR("Engine: Cannot reload a pipeline on an engine with live clones or on a clone.");
+        return false;
+    }
+    if (engine->kernel_count == 0 && engine->resource_count == 0) {
+        sf_engine_bind_pipeline(engine, pipe, programs);
+        return sf_atomic_load(&engine->error_code) == 0;
+    }
+
+    for (u32 i = 0; i < pipe->kernel_count; ++i) {
+        if (!programs[i]) return false;
+    }
+
+    sf_resource_inst* old_res = engine->resources;
+    u32 old_res_count = engine->resource_count;
+    sf_kernel_inst* old_ker = engine->kernels;
+    u32 old_ker_count = engine->kernel_count;
+
+    // The new generation's metadata goes into a fresh heap block; the previous one
+    // (or the bind-time arena space) is dropped once the reload commits
+    sf_allocator* alloc = sf_engine_alloc(engine);
+    sf_arena* prev_meta = engine->meta_arena;
+    void* prev_block = engine->reload_block;
+    size_t meta_bytes = _reload_meta_size(pipe, programs);
+    void* meta_block = alloc->alloc(alloc, meta_bytes);
+    if (!meta_block) {
+        SF_LOG_ERROR("Engine: Out of memory for hot reload metadata (%zu bytes).", meta_bytes);
+        return false;
+    }
+    sf_arena meta;
+    sf_arena_init(&meta, meta_block, meta_bytes);
+    engine->meta_arena = &meta;
+
+    sf_resource_inst* new_res = SF_ARENA_PUSH(engine->meta_arena, sf_resource_inst, pipe->resource_count);
+    sf_kernel_inst* new_ker = SF_ARENA_PUSH(engine->meta_arena, sf_kernel_inst, pipe->kernel_count);
+    int32_t* res_origin = malloc(sizeof(int32_t) * (pipe->resource_count + 1));
+    bool* ker_fresh = calloc(pipe->kernel_count + 1, sizeof(bool));
+    bool* res_fresh = calloc(pipe->resource_count + 1, sizeof(bool));
+    bool* old_res_kept = calloc(old_res_count + 1, sizeof(bool));
+    bool* old_ker_kept = calloc(old_ker_count + 1, sizeof(bool));
+    bool ok = (new_res || pipe->resource_count == 0) && (new_ker || pipe->kernel_count == 0) &&
+              res_origin && ker_fresh && res_fresh && old_res_kept && old_ker_kept;
+
+    // 1. Diff resources by name and declared layout
+    for (u32 i = 0; ok && i < pipe->resource_count; ++i) {
+        sf_pipeline_resource* d = &pipe->resources[i];
+        _setup_resource_inst(&new_res[i], d->name, d->dtype, d->shape, d->ndim, d->flags, engine->batch_size, engine->meta_arena);
+        _setup_resource_map(&new_res[i], d, engine->meta_arena);
+        res_origin[i] = -1;
+        for (u32 j = 0; j < old_res_count; ++j) {
+            if (!old_res_kept[j] && old_res[j].name_hash == new_res[i].name_hash && _same_decl(&old_res[j], &new_res[i])) {
+                res_origin[i] = (int32_t)j;
+                old_res_kept[j] = true;
+                break;
             }
         }
-        for (u32 s = 0; s < k->program->meta.symbol_count; ++s) {
-            sf_bin_symbol* sym = &k->program->symbols[s];
-            if (!(sym->flags & (SF_SYMBOL_FLAG_INPUT | SF_SYMBOL_FLAG_OUTPUT))) continue;
-            bool bound = false;
-            for (u32 b = 0; b < k->binding_count; ++b) if (k->bindings[b].local_reg == sym->register_idx) bound = true;
-            if (bound) continue;
-            int32_t r_idx = find_resource_idx(engine, sym->name_hash);
-            if (r_idx != -1) {
-                sf_kernel_binding* kb = &k->bindings[k->binding_count++];
-                kb->local_reg = (u16)sym->register_idx;
-                kb->global_res = (u16)r_idx;
-                kb->flags = sym->flags;
+    }
+
+    // 2. Diff kernels by id and program content; unchanged kernels keep state and bake
+    engine->resources = new_res;
+    engine->resource_count = pipe->resource_count;
+    for (u32 i = 0; ok && i < pipe->kernel_count; ++i) {
+        const sf_pipeline_kernel* d = &pipe->kernels[i];
+        sf_kernel_inst* k = &new_ker[i];
+        u32 id_hash = sf_fnv1a_hash(d->id);
+        u64 prog_hash = sf_engine_program_hash(engine, programs[i]);
+
+        _init_kernel_inst(engine, k, d, programs[i]);
+        ker_fresh[i] = true;
+        for (u32 j = 0; j < old_ker_count; ++j) {
+            sf_kernel_inst* o = &old_ker[j];
+            if (old_ker_kept[j] || o->id_hash != id_hash) continue;
+            if (o->program != programs[i] && (prog_hash == 0 || o->program_hash != prog_hash)) continue;
+            k->program = o->program;
+            k->program_hash = o->program_hash;
+            k->state = o->state;
+            old_ker_kept[j] = true;
+            ker_fresh[i] = false;
+            break;
+        }
+        ok = _bind_kernel_ports(engine, k, d);
+    }
+
+    // 3. Allocate changed resources (nothing old is released before this succeeds)
+    if (ok) {
+        engine->kernels = new_ker;
+        engine->kernel_count = pipe->kernel_count;
+        analyze_transience(engine);
+        for (u32 i = 0; ok && i < pipe->resource_count; ++i) {
+            // A kept mapping was validated against the old kernels only
+            if (res_origin[i] != -1) { ok = sf_engine_check_mapped_writes(engine, &new_res[i]); continue; }
+            res_fresh[i] = true;
+            ok = _allocate_resource(engine, &new_res[i]);
+        }
+    }
+
+    if (!ok) {
+        SF_LOG_ERROR("Engine: Hot reload failed. Keeping previous pipeline.");
+        for (u32 i = 0; res_fresh && i < pipe->resource_count; ++i) if (res_fresh[i]) _free_resource(&new_res[i]);
+        engine->resources = old_res;
+        engine->resource_count = old_res_count;
+        engine->kernels = old_ker;
+        engine->kernel_count = old_ker_count;
+        engine->meta_arena = prev_meta;
+        alloc->free(alloc, meta_block);
+        free(res_origin); free(ker_fresh); free(res_fresh); free(old_res_kept); free(old_ker_kept);
+        return false;
+    }
+
+    // 4. Commit: move surviving buffers, release what disappeared
+    u32 kept_res = 0, kept_ker = 0;
+    for (u32 i = 0; i < pipe->resource_count; ++i) {
+        if (res_origin[i] == -1) continue;
+        if (!_adopt_resource(engine, &new_res[i], &old_res[res_origin[i]])) {
+            SF_LOG_ERROR("Engine: Hot reload could not re-buffer resource '%s'.", new_res[i].name);
+            sf_atomic_store(&engine->error_code, SF_ENGINE_ERR_OOM);
+        }
+        kept_res++;
+    }
+    for (u32 j = 0; j < old_res_count; ++j) if (!old_res_kept[j]) _free_resource(&old_res[j]);
+    for (u32 j = 0; j < old_ker_count; ++j) if (!old_ker_kept[j]) sf_state_shutdown(&old_ker[j].state, &engine->backend);
+
+    apply_initial_data(engine, res_fresh);
+
+    for (u32 i = 0; i < pipe->kernel_count; ++i) {
+        if (!ker_fresh[i]) {
+            // Kept registers stay put; only their tables move out of the old metadata
+            if (!sf_state_relocate(&new_ker[i].state, engine->meta_arena)) sf_atomic_store(&engine->error_code, SF_ENGINE_ERR_OOM);
+            kept_ker++;
+            continue;
+        }
+        sf_state_reset(&new_ker[i].state, new_ker[i].program, engine->meta_arena);
+    }
+    sf_engine_bake_kernels(engine, ker_fresh);
+    sf_engine_prune_programs(engine);
+    sf_engine_drop_rewind_point(engine); // Indexed by the previous generation's resources
+
+    engine->reload_arena = meta;
+    engine->meta_arena = &engine->reload_arena;
+    engine->reload_block = meta_block;
+    if (prev_block) alloc->free(alloc, prev_block);
+    sf_engine_track_arena(engine);
+
+    SF_LOG_INFO("Engine: Hot reload kept %u/%u resources and %u/%u kernels.", kept_res, pipe->resource_count, kept_ker, pipe->kernel_count);
+    free(res_origin); free(ker_fresh); free(res_fresh); free(old_res_kept); free(old_ker_kept);
+    return true;
+}
+
+// --- Rewind ---
+
+/**
+ * Initial data a kernel declared for a resource (NULL if none). Sets *written if any
+ * kernel binds the resource as an output.
+ */
+static const void* _resource_initial_data(sf_engine* engine, u32 res_idx, bool* written) {
+    const void* data = NULL;
+    *written = false;
+    for (u32 k = 0; k < engine->kernel_count; ++k) {
+        sf_kernel_inst* ker = &engine->kernels[k];
+        for (u32 b = 0; b < ker->binding_count; ++b) {
+            sf_kernel_binding* bind = &ker->bindings[b];
+            if (bind->global_res != res_idx) continue;
+            if (bind->flags & SF_SYMBOL_FLAG_OUTPUT) *written = true;
+            if (!data) data = ker->program->tensor_data[bind->local_reg];
+        }
+    }
+    return data;
+}
+
+void sf_engine_rewind(sf_engine* engine) {
+    if (!engine) return;
+    sf_engine_cow_invalidate(engine);
+
+    // The rewind point (sf_engine_set_rewind_point) restores every resource as the host left
+    // it after setup. Without one, program constants are retained for the engine's lifetime,
+    // so they serve as the initial-state copy, and resources no kernel writes are untouched.
+    for (u32 i = 0; i < engine->resource_count; ++i) {
+        sf_resource_inst* res = &engine->resources[i];
+        if (res->size_bytes == 0 || res->map_flags) continue; // Files are not rolled back
+
+        const void* saved = sf_engine_rewind_data(engine, i);
+        if (saved) {
+            for (int b = 0; b < 2; ++b) {
+                if (b == 1 && res->buffers[1] == res->buffers[0]) continue;
+                if (res->buffers[b] && res->buffers[b]->data == saved) continue; // Still borrows it
+                if (!sf_engine_cow_write(engine, res, b, false)) continue;
+                if (res->buffers[b] && res->buffers[b]->data) memcpy(res->buffers[b]->data, saved, res->size_bytes);
             }
+            continue;
+        }
+
+        bool written;
+        const void* data = _resource_initial_data(engine, i, &written);
+        if (!written) continue;
+
+        // Resized (screen-size) resources no longer match their declared initial data
+        sf_tensor declared = {0};
+        declared.info = res->decl_info;
+        size_t bytes = sf_engine_instance_bytes(engine, res);
+        if (data && sf_tensor_size_bytes(&declared) != bytes) data = NULL;
+
+        for (int b = 0; b < 2; ++b) {
+            if (b == 1 && res->buffers[1] == res->buffers[0]) continue;
+            if (!sf_engine_cow_write(engine, res, b, false)) continue;
+            sf_buffer* buf = res->buffers[b];
+            if (!buf || !buf->data) continue;
+            if (!data) { memset(buf->data, 0, res->size_bytes); continue; }
+            for (u32 inst = 0; inst < engine->batch_size; ++inst) memcpy((u8*)buf->data + inst * bytes, data, bytes);
         }
     }
 
-    sf_engine_finalize_setup(engine);
+    engine->front_idx = 0;
+    engine->back_idx = 1;
+    for (u32 i = 0; i < engine->resource_count; ++i) {
+        engine->resources[i].desc.buffer = engine->resources[i].buffers[0];
+        engine->resources[i].desc.byte_offset = 0;
+    }
+    engine->frame_index = 0;
+    engine->roi_pending = false;
+    sf_atomic_store(&engine->error_code, 0);
 }
@@ -0,0 +1,257 @@
+#include <sionflow/engine/sf_pipeline.h>
+#include <sionflow/base/sf_log.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Binary pipeline descriptor layout (host byte order):
+ *   sf_pipeline_bin_header
+ *   sf_pipeline_bin_resource[resource_count]
+ *   sf_pipeline_bin_kernel[kernel_count]
+ *   sf_pipeline_bin_binding[binding_count]  (grouped by kernel, in kernel order)
+ *   string table (string_bytes, NUL-terminated strings referenced by offset)
+ *
+ * Records are fixed size, so decoding is a bounds check and a widening loop.
+ * The section may sit at any offset in a cartridge; records are read with memcpy.
+ */
+
+#define SF_PIPELINE_BIN_VERSION 3u
+#define SF_PIPELINE_BIN_SLACK   64u // Per arena allocation (alignment)
+
+typedef struct {
+    u32 magic;
+    u32 version;
+    u32 max_dims;      // SF_MAX_DIMS of the writer
+    u32 resource_count;
+    u32 kernel_count;
+    u32 binding_count;
+    u32 string_bytes;
+    u32 reserved;
+} sf_pipeline_bin_header;
+
+typedef struct {
+    u32 name;
+    u32 dtype;
+    i32 shape[SF_MAX_DIMS];
+    u8  ndim;
+    u8  flags;
+    u8  map_flags;
+    u8  reserved;
+    u32 map_path;      // String offset + 1, 0: not file-mapped
+} sf_pipeline_bin_resource;
+
+typedef struct {
+    u32 id;
+    u32 frequency;
+    u32 flags;
+    u32 first_binding;
+    u32 binding_count;
+} sf_pipeline_bin_kernel;
+
+typedef struct {
+    u32 kernel_port;
+    u32 global_resource;
+} sf_pipeline_bin_binding;
+
+static bool _read_header(const void* data, size_t size, sf_pipeline_bin_header* out) {
+    if (!data || size < sizeof(sf_pipeline_bin_header)) return false;
+    memcpy(out, data, sizeof(sf_pipeline_bin_header));
+    if (out->magic != SF_PIPELINE_BIN_MAGIC) return false;
+    if (out->version != SF_PIPELINE_BIN_VERSION || out->max_dims != SF_MAX_DIMS) return false;
+
+    u64 need = (u64)sizeof(sf_pipeline_bin_header)
+             + (u64)out->resource_count * sizeof(sf_pipeline_bin_resource)
+             + (u64)out->kernel_count * sizeof(sf_pipeline_bin_kernel)
+             + (u64)out->binding_count * sizeof(sf_pipeline_bin_binding)
+             + out->string_bytes;
+    if (need > size) return false;
+    // Every string offset must land on a terminated string
+    if (out->string_bytes > 0 && ((const char*)data)[need - 1] != '\0') return false;
+    return true;
+}
+
+bool sf_pipeline_bin_check(const void* data, size_t size) {
+    u32 magic = 0;
+    if (!data || size < sizeof(magic)) return false;
+    memcpy(&magic, data, sizeof(magic));
+    return magic == SF_PIPELINE_BIN_MAGIC;
+}
+
+size_t sf_pipeline_bin_arena_size(const void* data, size_t size) {
+    sf_pipeline_bin_header head;
+    if (!_read_header(data, size, &head)) return 0;
+    return (size_t)head.resource_count * sizeof(sf_pipeline_resource)
+         + (size_t)head.kernel_count * sizeof(sf_pipeline_kernel)
+         + (size_t)head.binding_count * sizeof(sf_pipeline_binding)
+         + head.string_bytes
+         + 5 * SF_PIPELINE_BIN_SLACK;
+}
+
+static const char* _string(const char* table, u32 bytes, u32 offset) {
+    return offset < bytes ? table + offset : NULL;
+}
+
+bool sf_pipeline_bin_decode(const void* data, size_t size, const char* graph_path, sf_arena* arena, sf_pipeline_desc* out) {
+    if (!arena || !out) return false;
+    sf_pipeline_bin_header head;
+    if (!_read_header(data, size, &head)) {
+        SF_LOG_ERROR("Pipeline: Binary descriptor is malformed or was written for another layout.");
+        return false;
+    }
+
+    const u8* cursor = (const u8*)data + sizeof(sf_pipeline_bin_header);
+    const u8* res_recs = cursor;
+    const u8* ker_recs = res_recs + (size_t)head.resource_count * sizeof(sf_pipeline_bin_resource);
+    const u8* bind_recs = ker_recs + (size_t)head.kernel_count * sizeof(sf_pipeline_bin_kernel);
+    const u8* str_src = bind_recs + (size_t)head.binding_count * sizeof(sf_pipeline_bin_binding);
+
+    memset(out, 0, sizeof(sf_pipeline_desc));
+    char* strings = head.string_bytes ? SF_ARENA_PUSH(arena, char, head.string_bytes) : NULL;
+    sf_pipeline_resource* resources = head.resource_count ? SF_ARENA_PUSH(arena, sf_pipeline_resource, head.resource_count) : NULL;
+    sf_pipeline_kernel* kernels = head.kernel_count ? SF_ARENA_PUSH(arena, sf_pipeline_kernel, head.kernel_count) : NULL;
+    sf_pipeline_binding* bindings = head.binding_count ? SF_ARENA_PUSH(arena, sf_pipeline_binding, head.binding_count) : NULL;
+    const char* path = graph_path ? sf_arena_strdup(arena, graph_path) : NULL;
+    if ((head.string_bytes && !strings) || (head.resource_count && !resources) ||
+        (head.kernel_count && !kernels) || (head.binding_count && !bindings) || (graph_path && !path)) {
+        SF_LOG_ERROR("Pipeline: Out of descriptor memory decoding binary pipeline.");
+        return false;
+    }
+    if (strings) memcpy(strings, str_src, head.string_bytes);
+
+    for (u32 i = 0; i < head.resource_count; ++i) {
+        sf_pipeline_bin_resource rec;
+        memcpy(&rec, res_recs + (size_t)i * sizeof(rec), sizeof(rec));
+        sf_pipeline_resource* dst = &resources[i];
+        dst->name = _string(strings, head.string_bytes, rec.name);
+        dst->dtype = (sf_dtype)rec.dtype;
+        dst->ndim = rec.ndim;
+        dst->flags = rec.flags;
+        dst->map_flags = rec.map_flags;
+        dst->map_path = rec.map_path ? _string(strings, head.string_bytes, rec.map_path - 1) : NULL;
+        if (!dst->name || rec.ndim > SF_MAX_DIMS || (rec.map_path && !dst->map_path)) goto malformed;
+        memcpy(dst->shape, rec.shape, sizeof(dst->shape));
+    }
+
+    for (u32 i = 0; i < head.binding_count; ++i) {
+        sf_pipeline_bin_binding rec;
+        memcpy(&rec, bind_recs + (size_t)i * sizeof(rec), sizeof(rec));
+        bindings[i].kernel_port = _string(strings, head.string_bytes, rec.kernel_port);
+        bindings[i].global_resource = _string(strings, head.string_bytes, rec.global_resource);
+        if (!bindings[i].kernel_port || !bindings[i].global_resource) goto malformed;
+    }
+
+    for (u32 i = 0; i < head.kernel_count; ++i) {
+        sf_pipeline_bin_kernel rec;
+        memcpy(&rec, ker_recs + (size_t)i * sizeof(rec), sizeof(rec));
+        sf_pipeline_kernel* dst = &kernels[i];
+        dst->id = _string(strings, head.string_bytes, rec.id);
+        dst->graph_path = path;
+        dst->frequency = rec.frequency ? rec.frequency : 1;
+        dst->flags = rec.flags;
+        if (!dst->id || (u64)rec.first_binding + rec.binding_count > head.binding_count) goto malformed;
+        dst->bindings = rec.binding_count ? &bindings[rec.first_binding] : NULL;
+        dst->binding_count = rec.binding_count;
+    }
+
+    out->resources = resources;
+    out->resource_count = head.resource_count;
+    out->kernels = kernels;
+    out->kernel_count = head.kernel_count;
+    return true;
+
+malformed:
+    SF_LOG_ERROR("Pipeline: Binary descriptor references data outside its tables.");
+    return false;
+}
+
+// --- Encoding ---
+
+typedef struct {
+    char* data;
+    u32   bytes;
+    u32   capacity;
+} sf_bin_strings;
+
+static bool _intern(sf_bin_strings* st, const char* s, u32* out_offset) {
+    if (!s) s = "";
+    size_t len = strlen(s) + 1;
+    if ((u64)st->bytes + len > UINT32_MAX) return false;
+    if (st->bytes + len > st->capacity) {
+        u32 cap = st->capacity ? st->capacity : 1024u;
+        while (cap < st->bytes + len) cap *= 2;
+        char* grown = realloc(st->data, cap);
+        if (!grown) return false;
+        st->data = grown;
+        st->capacity = cap;
+    }
+    memcpy(st->data + st->bytes, s, len);
+    *out_offset = st->bytes;
+    st->bytes += (u32)len;
+    return true;
+}
+
+void* sf_pipeline_bin_encode(const sf_pipeline_desc* pipe, size_t* out_size) {
+    if (!pipe) return NULL;
+
+    sf_pipeline_bin_header head = {
+        .magic = SF_PIPELINE_BIN_MAGIC,
+        .version = SF_PIPELINE_BIN_VERSION,
+        .max_dims = SF_MAX_DIMS,
+        .resource_count = pipe->resource_count,
+        .kernel_count = pipe->kernel_count
+    };
+    for (u32 k = 0; k < pipe->kernel_count; ++k) head.binding_count += pipe->kernels[k].binding_count;
+
+    size_t records = (size_t)head.resource_count * sizeof(sf_pipeline_bin_resource)
+                   + (size_t)head.kernel_count * sizeof(sf_pipeline_bin_kernel)
+                   + (size_t)head.binding_count * sizeof(sf_pipeline_bin_binding);
+    u8* recs = records ? calloc(1, records) : NULL;
+    sf_bin_strings st = {0};
+    if (records && !recs) return NULL;
+
+    u8* res_out = recs;
+    u8* ker_out = res_out + (size_t)head.resource_count * sizeof(sf_pipeline_bin_resource);
+    u8* bind_out = ker_out + (size_t)head.kernel_count * sizeof(sf_pipeline_bin_kernel);
+
+    bool ok = true;
+    for (u32 i = 0; ok && i < pipe->resource_count; ++i) {
+        const sf_pipeline_resource* src = &pipe->resources[i];
+        sf_pipeline_bin_resource rec = { .dtype = (u32)src->dtype, .ndim = src->ndim, .flags = src->flags };
+        memcpy(rec.shape, src->shape, sizeof(rec.shape));
+        ok = _intern(&st, src->name, &rec.name);
+        if (ok && src->map_path) {
+            ok = _intern(&st, src->map_path, &rec.map_path);
+            rec.map_path += 1;
+            rec.map_flags = src->map_flags;
+        }
+        memcpy(res_out + (size_t)i * sizeof(rec), &rec, sizeof(rec));
+    }
+
+    u32 binding = 0;
+    for (u32 k = 0; ok && k < pipe->kernel_count; ++k) {
+        const sf_pipeline_kernel* src = &pipe->kernels[k];
+        sf_pipeline_bin_kernel rec = { .frequency = src->frequency, .flags = src->flags, .first_binding = binding, .binding_count = src->binding_count };
+        ok = _intern(&st, src->id, &rec.id);
+        memcpy(ker_out + (size_t)k * sizeof(rec), &rec, sizeof(rec));
+
+        for (u32 b = 0; ok && b < src->binding_count; ++b, ++binding) {
+            sf_pipeline_bin_binding bind;
+            ok = _intern(&st, src->bindings[b].kernel_port, &bind.kernel_port) &&
+                 _intern(&st, src->bindings[b].global_resource, &bind.global_resource);
+            memcpy(bind_out + (size_t)binding * sizeof(bind), &bind, sizeof(bind));
+        }
+    }
+
+    head.string_bytes = st.bytes;
+    size_t total = sizeof(head) + records + st.bytes;
+    u8* blob = ok ? malloc(total) : NULL;
+    if (blob) {
+        memcpy(blob, &head, sizeof(head));
+        if (records) memcpy(blob + sizeof(head), recs, records);
+        if (st.bytes) memcpy(blob + sizeof(head) + records, st.data, st.bytes);
+        if (out_size) *out_size = total;
+    }
+    free(recs);
+    free(st.data);
+    return blob;
+}
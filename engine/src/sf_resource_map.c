@@ -0,0 +1,95 @@
+#include <sionflow/engine/sf_engine.h>
+#include "sf_engine_internal.h"
+#include "sf_vmem.h"
+#include <sionflow/base/sf_log.h>
+#include <string.h>
+
+/**
+ * File-backed resources.
+ *
+ * A mapped resource has one buffer whose data is a shared mapping of its file, so
+ * datasets larger than the engine heap are paged in by the OS as kernels sweep them.
+ * Kernels read (and, for writable mappings, update) it in place; writes land in the
+ * file, which then doubles as the resource's checkpoint (sf_engine_flush_mapped).
+ * Read-only mappings are copy-on-write: host writes through sf_engine_map_resource
+ * (asset loaders, named inputs) stay private and never reach the file.
+ */
+
+#define SF_MAP_PREFETCH_BYTES SF_MB(32) // Head of a resource read in ahead of its reader
+
+static bool _written_by_kernel(const sf_engine* engine, u32 res_idx) {
+    for (u32 k = 0; k < engine->kernel_count; ++k) {
+        const sf_kernel_inst* ker = &engine->kernels[k];
+        for (u32 b = 0; b < ker->binding_count; ++b) {
+            if (ker->bindings[b].global_res == res_idx && (ker->bindings[b].flags & SF_SYMBOL_FLAG_OUTPUT)) return true;
+        }
+    }
+    return false;
+}
+
+bool sf_engine_check_mapped_writes(const sf_engine* engine, const sf_resource_inst* res) {
+    if (!res->map_flags || (res->map_flags & SF_RESOURCE_MAP_WRITE)) return true;
+    if (!_written_by_kernel(engine, (u32)(res - engine->resources))) return true;
+    SF_LOG_ERROR("Engine: Resource '%s' is mapped read-only but a kernel writes it.", res->name);
+    return false;
+}
+
+bool sf_engine_map_file(sf_engine* engine, sf_resource_inst* res) {
+    bool writable = (res->map_flags & SF_RESOURCE_MAP_WRITE) != 0;
+    if (!res->map_path || res->size_bytes == 0) {
+        SF_LOG_ERROR("Engine: Mapped resource '%s' needs a file and a fixed shape.", res->name);
+        return false;
+    }
+    if (res->flags & SF_RESOURCE_FLAG_SCREEN_SIZE) {
+        SF_LOG_ERROR("Engine: Mapped resource '%s' cannot be screen-size.", res->name);
+        return false;
+    }
+    if (!sf_engine_check_mapped_writes(engine, res)) return false;
+
+    sf_buffer* buf = SF_ARENA_PUSH(engine->meta_arena, sf_buffer, 1);
+    if (!buf) return false;
+    memset(buf, 0, sizeof(sf_buffer));
+    buf->data = sf_vmem_map_file(res->map_path, res->size_bytes, writable);
+    if (!buf->data) {
+        SF_LOG_ERROR("Engine: Cannot map '%s' (%zu bytes%s) for resource '%s'.",
+            res->map_path, res->size_bytes, writable ? ", read/write" : "", res->name);
+        return false;
+    }
+    res->buffers[0] = res->buffers[1] = buf;
+
+    sf_vmem_advise(buf->data, res->size_bytes, SF_VMEM_ADVISE_SEQUENTIAL);
+    if (res->map_flags & SF_RESOURCE_MAP_PREFETCH) engine->map_prefetch = true;
+    return true;
+}
+
+void sf_engine_unmap_file(sf_resource_inst* res) {
+    if (res->buffers[0] && res->buffers[0]->data) sf_vmem_unmap_file(res->buffers[0]->data, res->size_bytes);
+    res->buffers[0] = res->buffers[1] = NULL;
+}
+
+void sf_engine_prefetch_kernel(sf_engine* engine, u32 k_idx) {
+    if (!engine->map_prefetch || k_idx >= engine->kernel_count) return;
+    const sf_kernel_inst* ker = &engine->kernels[k_idx];
+    for (u32 b = 0; b < ker->binding_count; ++b) {
+        if (!(ker->bindings[b].flags & SF_SYMBOL_FLAG_INPUT)) continue;
+        const sf_resource_inst* res = &engine->resources[ker->bindings[b].global_res];
+        if (!(res->map_flags & SF_RESOURCE_MAP_PREFETCH) || !res->buffers[0] || !res->buffers[0]->data) continue;
+        // Sequential readahead takes over once the kernel is streaming through it
+        size_t bytes = res->size_bytes < SF_MAP_PREFETCH_BYTES ? res->size_bytes : SF_MAP_PREFETCH_BYTES;
+        sf_vmem_advise(res->buffers[0]->data, bytes, SF_VMEM_ADVISE_WILLNEED);
+    }
+}
+
+bool sf_engine_flush_mapped(sf_engine* engine) {
+    if (!engine) return false;
+    bool ok = true;
+    for (u32 i = 0; i < engine->resource_count; ++i) {
+        sf_resource_inst* res = &engine->resources[i];
+        if (!(res->map_flags & SF_RESOURCE_MAP_WRITE) || !res->buffers[0] || !res->buffers[0]->data) continue;
+        if (!sf_vmem_flush(res->buffers[0]->data, res->size_bytes)) {
+            SF_LOG_ERROR("Engine: Failed to flush mapped resource '%s' to '%s'.", res->name, res->map_path);
+            ok = false;
+        }
+    }
+    return ok;
+}
@@ -0,0 +1,241 @@
+#include <sionflow/engine/sf_engine.h>
+#include "sf_engine_internal.h"
+#include "sf_vmem.h"
+#include <sionflow/base/sf_log.h>
+#include <sionflow/base/sf_shape.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Snapshot file layout (little-endian, host byte order):
+ *   sf_snapshot_header
+ *   sf_snapshot_entry[entry_count]
+ *   payloads, each starting at a SF_SNAPSHOT_ALIGN boundary (file can be mapped and used in place)
+ */
+
+#define SF_SNAPSHOT_MAGIC   0x4E534653u // "SFSN"
+#define SF_SNAPSHOT_VERSION 2u
+#define SF_SNAPSHOT_ALIGN   64u
+
+typedef struct {
+    u32 magic;
+    u32 version;
+    u64 frame_index;
+    u32 entry_count;
+    u32 max_dims;     // SF_MAX_DIMS of the writer
+    u64 data_offset;  // First payload byte
+    u32 batch_size;   // Instances per resource; entry sizes cover all of them
+    u32 reserved;
+} sf_snapshot_header;
+
+typedef struct {
+    u32 name_hash;
+    u32 dtype;
+    u32 ndim;
+    u32 flags;
+    i32 shape[SF_MAX_DIMS];
+    u64 offset;
+    u64 size;
+} sf_snapshot_entry;
+
+static u64 _align_up(u64 v) {
+    return (v + SF_SNAPSHOT_ALIGN - 1) & ~(u64)(SF_SNAPSHOT_ALIGN - 1);
+}
+
+static bool _write_padding(FILE* f, u64 from, u64 to) {
+    static const u8 zeros[SF_SNAPSHOT_ALIGN] = {0};
+    return (to == from) || fwrite(zeros, 1, (size_t)(to - from), f) == (size_t)(to - from);
+}
+
+bool sf_engine_snapshot(sf_engine* engine, const char* path, sf_snapshot_scope scope) {
+    if (!engine || !path) return false;
+
+    u32 count = 0;
+    for (u32 i = 0; i < engine->resource_count; ++i) {
+        sf_resource_inst* res = &engine->resources[i];
+        if (scope == SF_SNAPSHOT_PERSISTENT && !(res->flags & SF_RESOURCE_FLAG_PERSISTENT)) continue;
+        if (res->map_flags) continue; // Checkpointed by its own file
+        if (res->buffers[engine->front_idx] && res->buffers[engine->front_idx]->data) count++;
+    }
+
+    sf_snapshot_entry* entries = calloc(count + 1, sizeof(sf_snapshot_entry));
+    sf_resource_inst** sources = calloc(count + 1, sizeof(sf_resource_inst*));
+    if (!entries || !sources) { free(entries); free(sources); return false; }
+
+    sf_snapshot_header head = { SF_SNAPSHOT_MAGIC, SF_SNAPSHOT_VERSION, engine->frame_index, count, SF_MAX_DIMS, 0, engine->batch_size, 0 };
+    head.data_offset = _align_up(sizeof(head) + sizeof(sf_snapshot_entry) * count);
+
+    u64 offset = head.data_offset;
+    for (u32 i = 0, e = 0; i < engine->resource_count; ++i) {
+        sf_resource_inst* res = &engine->resources[i];
+        if (scope == SF_SNAPSHOT_PERSISTENT && !(res->flags & SF_RESOURCE_FLAG_PERSISTENT)) continue;
+        if (res->map_flags) continue;
+        if (!res->buffers[engine->front_idx] || !res->buffers[engine->front_idx]->data) continue;
+
+        sf_snapshot_entry* en = &entries[e];
+        en->name_hash = res->name_hash;
+        en->dtype = (u32)res->desc.info.dtype;
+        en->ndim = res->desc.info.ndim;
+        en->flags = res->flags;
+        memcpy(en->shape, res->desc.info.shape, sizeof(i32) * SF_MAX_DIMS);
+        en->offset = offset;
+        en->size = res->size_bytes;
+        sources[e++] = res;
+        offset = _align_up(offset + en->size);
+    }
+
+    // Written next to the target and renamed over it, so the previous checkpoint
+    // survives until the new one is complete
+    size_t path_len = strlen(path);
+    char* tmp_path = malloc(path_len + 5);
+    FILE* f = NULL;
+    if (tmp_path) {
+        memcpy(tmp_path, path, path_len);
+        memcpy(tmp_path + path_len, ".tmp", 5);
+        f = fopen(tmp_path, "wb");
+    }
+    if (!f) {
+        SF_LOG_ERROR("Engine: Cannot open snapshot '%s' for writing.", tmp_path ? tmp_path : path);
+        free(tmp_path); free(entries); free(sources);
+        return false;
+    }
+
+    bool ok = fwrite(&head, sizeof(head), 1, f) == 1 &&
+              (count == 0 || fwrite(entries, sizeof(sf_snapshot_entry), count, f) == count);
+    u64 pos = sizeof(head) + sizeof(sf_snapshot_entry) * count;
+    for (u32 e = 0; ok && e < count; ++e) {
+        ok = _write_padding(f, pos, entries[e].offset);
+        const void* data = sources[e]->buffers[engine->front_idx]->data;
+        ok = ok && fwrite(data, 1, (size_t)entries[e].size, f) == (size_t)entries[e].size;
+        pos = entries[e].offset + entries[e].size;
+    }
+    ok = (fclose(f) == 0) && ok;
+    if (!ok || !sf_engine_replace_file(tmp_path, path)) {
+        remove(tmp_path);
+        ok = false;
+    }
+    free(tmp_path);
+
+    ok = sf_engine_flush_mapped(engine) && ok;
+
+    if (ok) SF_LOG_INFO("Engine: Snapshot of %u resources written to '%s' (frame %llu).", count, path, (unsigned long long)engine->frame_index);
+    else SF_LOG_ERROR("Engine: Failed writing snapshot '%s'.", path);
+    free(entries); free(sources);
+    return ok;
+}
+
+static bool _validate_entry(sf_engine* engine, const sf_snapshot_header* head, const sf_snapshot_entry* en, int32_t* out_idx) {
+    int32_t idx = find_resource_idx(engine, en->name_hash);
+    if (idx == -1) {
+        SF_LOG_ERROR("Engine: Snapshot resource #%08x is not part of the bound pipeline.", en->name_hash);
+        return false;
+    }
+    sf_resource_inst* res = &engine->resources[idx];
+    if ((u32)res->desc.info.dtype != en->dtype || res->desc.info.ndim != en->ndim) {
+        SF_LOG_ERROR("Engine: Snapshot resource '%s' has mismatching dtype/rank.", res->name);
+        return false;
+    }
+
+    // Entries hold every instance, each with the entry's shape
+    u64 bytes = (u64)sf_shape_calc_bytes((sf_dtype)en->dtype, en->shape, (uint8_t)en->ndim) * head->batch_size;
+    if (bytes != en->size) {
+        SF_LOG_ERROR("Engine: Snapshot resource '%s' has an inconsistent size.", res->name);
+        return false;
+    }
+
+    // Screen-size resources follow the window; everything else must match the bound layout
+    if (!(res->flags & SF_RESOURCE_FLAG_SCREEN_SIZE) &&
+        memcmp(res->desc.info.shape, en->shape, sizeof(i32) * en->ndim) != 0) {
+        SF_LOG_ERROR("Engine: Snapshot resource '%s' has a mismatching shape.", res->name);
+        return false;
+    }
+    *out_idx = idx;
+    return true;
+}
+
+static bool _file_size(const char* path, u64* out_size) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return false;
+#ifdef _WIN32
+    bool ok = _fseeki64(f, 0, SEEK_END) == 0;
+    long long end = ok ? _ftelli64(f) : -1;
+#else
+    bool ok = fseeko(f, 0, SEEK_END) == 0;
+    long long end = ok ? (long long)ftello(f) : -1;
+#endif
+    fclose(f);
+    if (end < 0) return false;
+    *out_size = (u64)end;
+    return true;
+}
+
+bool sf_engine_restore(sf_engine* engine, const char* path) {
+    if (!engine || !path) return false;
+
+    u64 file_size = 0;
+    if (!_file_size(path, &file_size) || file_size < sizeof(sf_snapshot_header) || file_size > SIZE_MAX) {
+        SF_LOG_ERROR("Engine: Cannot open snapshot '%s'.", path);
+        return false;
+    }
+    // Payloads are copied straight out of the mapping (no intermediate read buffers)
+    const u8* file = sf_vmem_map_file(path, (size_t)file_size, false);
+    if (!file) {
+        SF_LOG_ERROR("Engine: Cannot map snapshot '%s'.", path);
+        return false;
+    }
+
+    sf_snapshot_header head;
+    memcpy(&head, file, sizeof(head));
+    u64 table_end = sizeof(head) + sizeof(sf_snapshot_entry) * (u64)head.entry_count;
+    bool ok = head.magic == SF_SNAPSHOT_MAGIC && head.version == SF_SNAPSHOT_VERSION &&
+              head.max_dims == SF_MAX_DIMS && table_end <= file_size;
+    if (!ok) SF_LOG_ERROR("Engine: '%s' is not a compatible snapshot.", path);
+    if (ok && head.batch_size != engine->batch_size) {
+        SF_LOG_ERROR("Engine: Snapshot '%s' holds %u instances per resource, the engine runs %u.", path, head.batch_size, engine->batch_size);
+        ok = false;
+    }
+
+    sf_snapshot_entry* entries = ok ? calloc(head.entry_count + 1, sizeof(sf_snapshot_entry)) : NULL;
+    int32_t* targets = ok ? calloc(head.entry_count + 1, sizeof(int32_t)) : NULL;
+    ok = ok && entries && targets;
+    if (ok) memcpy(entries, file + sizeof(head), sizeof(sf_snapshot_entry) * head.entry_count);
+
+    // 1. Validate everything, including payload extents, before touching engine state
+    for (u32 e = 0; ok && e < head.entry_count; ++e) {
+        const sf_snapshot_entry* en = &entries[e];
+        ok = _validate_entry(engine, &head, en, &targets[e]);
+        if (ok && (en->offset < table_end || en->offset > file_size || en->size > file_size - en->offset)) {
+            SF_LOG_ERROR("Engine: Snapshot '%s' is truncated or corrupt.", path);
+            ok = false;
+        }
+    }
+
+    // 2. Copy payloads into the front buffers
+    for (u32 e = 0; ok && e < head.entry_count; ++e) {
+        sf_snapshot_entry* en = &entries[e];
+        sf_resource_inst* res = &engine->resources[targets[e]];
+        if (res->map_flags) continue; // The mapped file is authoritative
+
+        if (res->size_bytes != en->size || memcmp(res->desc.info.shape, en->shape, sizeof(i32) * en->ndim) != 0) {
+            if (!sf_engine_resize_resource(engine, res->name, en->shape, (uint8_t)en->ndim)) { ok = false; break; }
+        }
+        if (!sf_engine_cow_write(engine, res, engine->front_idx, false)) { ok = false; break; }
+        sf_buffer* front = res->buffers[engine->front_idx];
+        if (!front || !front->data) { ok = false; break; }
+
+        memcpy(front->data, file + en->offset, (size_t)en->size);
+        sf_engine_sync_resource(engine, res->name);
+    }
+    sf_vmem_unmap_file((void*)file, (size_t)file_size);
+
+    if (ok) {
+        engine->frame_index = head.frame_index;
+        sf_atomic_store(&engine->error_code, 0);
+        SF_LOG_INFO("Engine: Restored %u resources from '%s' (frame %llu).", head.entry_count, path, (unsigned long long)head.frame_index);
+    } else {
+        SF_LOG_ERROR("Engine: Failed to restore snapshot '%s'.", path);
+    }
+    free(entries); free(targets);
+    return ok;
+}
@@ -0,0 +1,166 @@
+#include <sionflow/engine/sf_thread.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#define SF_THREAD_MAX_TRACKED 256 // Helper threads sf_thread_is_helper can name at once
+
+static sf_atomic_i32 g_helper_tids[SF_THREAD_MAX_TRACKED]; // 0 = free slot
+#endif
+
+struct sf_thread {
+#ifdef _WIN32
+    HANDLE handle;
+#else
+    pthread_t handle;
+#endif
+    sf_thread_fn fn;
+    void* user_data;
+};
+
+#ifdef _WIN32
+static DWORD WINAPI _thread_entry(LPVOID arg) {
+    sf_thread* t = (sf_thread*)arg;
+    t->fn(t->user_data);
+    return 0;
+}
+#else
+static void* _thread_entry(void* arg) {
+    sf_thread* t = (sf_thread*)arg;
+#ifdef __linux__
+    int32_t tid = (int32_t)syscall(SYS_gettid);
+    sf_atomic_i32* slot = NULL;
+    for (u32 i = 0; i < SF_THREAD_MAX_TRACKED && !slot; ++i) {
+        if (sf_atomic_i32_compare_exchange(&g_helper_tids[i], 0, tid)) slot = &g_helper_tids[i];
+    }
+    t->fn(t->user_data);
+    if (slot) sf_atomic_store(slot, 0);
+#else
+    t->fn(t->user_data);
+#endif
+    return NULL;
+}
+#endif
+
+sf_thread* sf_thread_start(sf_thread_fn fn, void* user_data) {
+    if (!fn) return NULL;
+    sf_thread* t = malloc(sizeof(sf_thread));
+    if (!t) return NULL;
+    t->fn = fn;
+    t->user_data = user_data;
+#ifdef _WIN32
+    t->handle = CreateThread(NULL, 0, _thread_entry, t, 0, NULL);
+    if (!t->handle) { free(t); return NULL; }
+#else
+    if (pthread_create(&t->handle, NULL, _thread_entry, t) != 0) { free(t); return NULL; }
+#endif
+    return t;
+}
+
+void sf_thread_join(sf_thread* thread) {
+    if (!thread) return;
+#ifdef _WIN32
+    WaitForSingleObject(thread->handle, INFINITE);
+    CloseHandle(thread->handle);
+#else
+    pthread_join(thread->handle, NULL);
+#endif
+    free(thread);
+}
+
+u32 sf_thread_hw_count(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (u32)info.dwNumberOfProcessors : 1;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (u32)n : 1;
+#endif
+}
+
+bool sf_thread_is_helper(int64_t os_tid) {
+#ifdef __linux__
+    for (u32 i = 0; i < SF_THREAD_MAX_TRACKED; ++i) {
+        if (sf_atomic_load(&g_helper_tids[i]) == (int32_t)os_tid) return os_tid != 0;
+    }
+#else
+    (void)os_tid;
+#endif
+    return false;
+}
+
+// --- Atomics ---
+
+int32_t sf_atomic_i32_fetch_add(sf_atomic_i32* ptr, int32_t value) {
+#ifdef _MSC_VER
+    return (int32_t)InterlockedExchangeAdd((volatile LONG*)ptr, (LONG)value);
+#else
+    return __atomic_fetch_add((volatile int32_t*)ptr, value, __ATOMIC_ACQ_REL);
+#endif
+}
+
+int32_t sf_atomic_i32_exchange(sf_atomic_i32* ptr, int32_t value) {
+#ifdef _MSC_VER
+    return (int32_t)InterlockedExchange((volatile LONG*)ptr, (LONG)value);
+#else
+    return __atomic_exchange_n((volatile int32_t*)ptr, value, __ATOMIC_ACQ_REL);
+#endif
+}
+
+bool sf_atomic_i32_compare_exchange(sf_atomic_i32* ptr, int32_t expected, int32_t desired) {
+#ifdef _MSC_VER
+    return InterlockedCompareExchange((volatile LONG*)ptr, (LONG)desired, (LONG)expected) == (LONG)expected;
+#else
+    return __atomic_compare_exchange_n((volatile int32_t*)ptr, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+// --- Parallel For ---
+
+typedef struct {
+    sf_parallel_fn fn;
+    void* ctx;
+    u32 count;
+    sf_atomic_i32 next;
+} sf_parallel_job;
+
+static void _parallel_worker(void* user_data) {
+    sf_parallel_job* job = (sf_parallel_job*)user_data;
+    for (;;) {
+        u32 i = (u32)sf_atomic_i32_fetch_add(&job->next, 1);
+        if (i >= job->count) break;
+        job->fn(job->ctx, i);
+    }
+}
+
+void sf_parallel_for(u32 count, u32 max_threads, sf_parallel_fn fn, void* ctx) {
+    if (!fn || count == 0) return;
+
+    u32 threads = max_threads ? max_threads : sf_thread_hw_count();
+    if (threads > count) threads = count;
+
+    sf_parallel_job job = { fn, ctx, count, {0} };
+    if (threads <= 1) {
+        _parallel_worker(&job);
+        return;
+    }
+
+    sf_thread** workers = calloc(threads - 1, sizeof(sf_thread*));
+    if (workers) {
+        for (u32 i = 0; i < threads - 1; ++i) workers[i] = sf_thread_start(_parallel_worker, &job);
+    }
+    _parallel_worker(&job);
+    if (workers) {
+        for (u32 i = 0; i < threads - 1; ++i) sf_thread_join(workers[i]);
+        free(workers);
+    }
+}
@@ -0,0 +1,289 @@
+#include "sf_vmem.h"
+#include <sionflow/engine/sf_engine.h>
+#include <sionflow/engine/sf_thread.h>
+#include <sionflow/base/sf_log.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#define SF_MPOL_PREFERRED 1
+#define SF_MPOL_BIND      2
+#endif
+
+#define SF_HUGE_PAGE_SIZE SF_MB(2)
+
+#if !defined(_WIN32) && !defined(MAP_NORESERVE)
+#define MAP_NORESERVE 0
+#endif
+
+#ifdef _WIN32
+/**
+ * Windows has no overcommit: committed pages are charged up front even if never touched.
+ * Regions are therefore only reserved and registered here; a vectored exception handler
+ * commits SF_VMEM_COMMIT_CHUNK around the first access to an uncommitted page and resumes.
+ * If the registry is full, a region is committed whole instead.
+ */
+#define SF_VMEM_MAX_REGIONS  1024
+#define SF_VMEM_COMMIT_CHUNK SF_MB(1)
+
+static struct {
+    u8*    base[SF_VMEM_MAX_REGIONS];
+    size_t size[SF_VMEM_MAX_REGIONS];
+    u32    count;
+    SRWLOCK lock;
+    PVOID  handler;
+} g_vmem = { .lock = SRWLOCK_INIT };
+
+// Caller holds g_vmem.lock
+static i32 _region_of(const void* ptr) {
+    for (u32 i = 0; i < g_vmem.count; ++i) {
+        if ((const u8*)ptr >= g_vmem.base[i] && (const u8*)ptr < g_vmem.base[i] + g_vmem.size[i]) return (i32)i;
+    }
+    return -1;
+}
+
+static LONG CALLBACK _commit_on_fault(EXCEPTION_POINTERS* info) {
+    const EXCEPTION_RECORD* rec = info->ExceptionRecord;
+    if (rec->ExceptionCode != EXCEPTION_ACCESS_VIOLATION || rec->NumberParameters < 2) return EXCEPTION_CONTINUE_SEARCH;
+    const u8* addr = (const u8*)rec->ExceptionInformation[1];
+
+    LONG result = EXCEPTION_CONTINUE_SEARCH;
+    AcquireSRWLockShared(&g_vmem.lock);
+    i32 r = _region_of(addr);
+    if (r >= 0) {
+        size_t offset = (size_t)(addr - g_vmem.base[r]) & ~(size_t)(SF_VMEM_COMMIT_CHUNK - 1);
+        size_t len = g_vmem.size[r] - offset < SF_VMEM_COMMIT_CHUNK ? g_vmem.size[r] - offset : SF_VMEM_COMMIT_CHUNK;
+        // Fails only when the commit limit is reached: let the access violation through
+        if (VirtualAlloc(g_vmem.base[r] + offset, len, MEM_COMMIT, PAGE_READWRITE)) result = EXCEPTION_CONTINUE_EXECUTION;
+    }
+    ReleaseSRWLockShared(&g_vmem.lock);
+    return result;
+}
+
+static bool _region_add(void* ptr, size_t size) {
+    AcquireSRWLockExclusive(&g_vmem.lock);
+    if (!g_vmem.handler) g_vmem.handler = AddVectoredExceptionHandler(1, _commit_on_fault);
+    bool ok = g_vmem.handler && g_vmem.count < SF_VMEM_MAX_REGIONS;
+    if (ok) {
+        g_vmem.base[g_vmem.count] = (u8*)ptr;
+        g_vmem.size[g_vmem.count] = size;
+        g_vmem.count++;
+    }
+    ReleaseSRWLockExclusive(&g_vmem.lock);
+    return ok;
+}
+
+static void _region_remove(void* ptr) {
+    AcquireSRWLockExclusive(&g_vmem.lock);
+    i32 r = _region_of(ptr);
+    if (r >= 0) {
+        g_vmem.count--;
+        g_vmem.base[r] = g_vmem.base[g_vmem.count];
+        g_vmem.size[r] = g_vmem.size[g_vmem.count];
+    }
+    ReleaseSRWLockExclusive(&g_vmem.lock);
+}
+
+static bool _region_known(const void* ptr) {
+    AcquireSRWLockShared(&g_vmem.lock);
+    bool known = _region_of(ptr) >= 0;
+    ReleaseSRWLockShared(&g_vmem.lock);
+    return known;
+}
+#endif
+
+void* sf_vmem_reserve(size_t size) {
+    if (size == 0) return NULL;
+#ifdef _WIN32
+    void* ptr = VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_READWRITE);
+    if (ptr && !_region_add(ptr, size) && !VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE)) {
+        VirtualFree(ptr, 0, MEM_RELEASE);
+        return NULL;
+    }
+    return ptr;
+#else
+    void* ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return (ptr == MAP_FAILED) ? NULL : ptr;
+#endif
+}
+
+void sf_vmem_release(void* ptr, size_t size) {
+    if (!ptr) return;
+#ifdef _WIN32
+    (void)size;
+    _region_remove(ptr);
+    VirtualFree(ptr, 0, MEM_RELEASE);
+#else
+    munmap(ptr, size);
+#endif
+}
+
+bool sf_vmem_commit(void* ptr, size_t size) {
+    if (!ptr || size == 0) return true;
+#ifdef _WIN32
+    size_t page = sf_vmem_page_size();
+    size_t start = (size_t)ptr & ~(page - 1);
+    size_t end = ((size_t)ptr + size + page - 1) & ~(page - 1);
+    return VirtualAlloc((void*)start, end - start, MEM_COMMIT, PAGE_READWRITE) != NULL;
+#else
+    return true;
+#endif
+}
+
+void sf_vmem_decommit(void* ptr, size_t size) {
+    if (!ptr || size == 0) return;
+    size_t page = sf_vmem_page_size();
+    size_t start = ((size_t)ptr + page - 1) & ~(page - 1);
+    size_t end = ((size_t)ptr + size) & ~(page - 1);
+    if (end <= start) return;
+#ifdef _WIN32
+    // Registered regions recommit on the next touch; a region committed whole must stay so
+    if (_region_known(ptr)) VirtualFree((void*)start, end - start, MEM_DECOMMIT);
+    else VirtualAlloc((void*)start, end - start, MEM_RESET, PAGE_READWRITE);
+#else
+    madvise((void*)start, end - start, MADV_DONTNEED);
+#endif
+}
+
+void* sf_vmem_map_large(size_t size, int mode, size_t* out_size) {
+    if (size == 0) return NULL;
+    size_t rounded = (size + SF_HUGE_PAGE_SIZE - 1) & ~(SF_HUGE_PAGE_SIZE - 1);
+    void* ptr = NULL;
+
+#if defined(__linux__) && defined(MAP_HUGETLB)
+    if (mode == SF_PAGES_EXPLICIT) {
+        ptr = mmap(NULL, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (ptr == MAP_FAILED) {
+            static sf_atomic_i32 warned; // Engines on several threads may get here at once
+            if (sf_atomic_i32_exchange(&warned, 1) == 0) SF_LOG_WARN("Engine: Explicit huge pages unavailable, using transparent huge pages.");
+            ptr = NULL;
+        }
+    }
+#endif
+    if (!ptr) {
+#ifdef _WIN32
+        ptr = sf_vmem_reserve(rounded);
+        if (!ptr) return NULL;
+        (void)mode;
+#else
+        // Over-reserve and trim, so the region starts on a huge page boundary.
+        // Transparent huge pages only back aligned 2MB ranges.
+        u8* raw = sf_vmem_reserve(rounded + SF_HUGE_PAGE_SIZE);
+        if (!raw) return NULL;
+        size_t head = (SF_HUGE_PAGE_SIZE - ((size_t)raw & (SF_HUGE_PAGE_SIZE - 1))) & (SF_HUGE_PAGE_SIZE - 1);
+        if (head) munmap(raw, head);
+        if (SF_HUGE_PAGE_SIZE - head) munmap(raw + head + rounded, SF_HUGE_PAGE_SIZE - head);
+        ptr = raw + head;
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+        if (mode != SF_PAGES_DEFAULT) madvise(ptr, rounded, MADV_HUGEPAGE);
+#else
+        (void)mode;
+#endif
+#endif
+    }
+    if (out_size) *out_size = rounded;
+    return ptr;
+}
+
+bool sf_vmem_bind_numa(void* ptr, size_t size, u64 node_mask) {
+    if (!ptr || size == 0 || node_mask == 0) return false;
+#ifdef __linux__
+    unsigned long mask = (unsigned long)node_mask;
+    int mode = ((node_mask & (node_mask - 1)) == 0) ? SF_MPOL_PREFERRED : SF_MPOL_BIND;
+    // The kernel reads maxnode - 1 bits of the mask
+    if (syscall(SYS_mbind, ptr, size, mode, &mask, sizeof(mask) * 8 + 1, 0) != 0) {
+        SF_LOG_WARN("Engine: NUMA binding to node mask 0x%llx failed.", (unsigned long long)node_mask);
+        return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void* sf_vmem_map_file(const char* path, size_t size, bool writable) {
+    if (!path || size == 0) return NULL;
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, writable ? (GENERIC_READ | GENERIC_WRITE) : GENERIC_READ, FILE_SHARE_READ,
+                              NULL, writable ? OPEN_ALWAYS : OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) return NULL;
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || (!writable && (u64)file_size.QuadPart < (u64)size)) {
+        CloseHandle(file);
+        return NULL;
+    }
+    // Creating a writable mapping larger than the file grows it; read-only files are mapped copy-on-write
+    HANDLE mapping = CreateFileMappingA(file, NULL, writable ? PAGE_READWRITE : PAGE_WRITECOPY,
+                                        (DWORD)((u64)size >> 32), (DWORD)((u64)size & 0xFFFFFFFFu), NULL);
+    CloseHandle(file);
+    if (!mapping) return NULL;
+    void* ptr = MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_COPY, 0, 0, size);
+    CloseHandle(mapping); // The view keeps the mapping alive
+    return ptr;
+#else
+    int fd = open(path, writable ? (O_RDWR | O_CREAT) : O_RDONLY, 0644);
+    if (fd < 0) return NULL;
+    struct stat st;
+    bool ok = fstat(fd, &st) == 0;
+    if (ok && (u64)st.st_size < (u64)size) ok = writable && ftruncate(fd, (off_t)size) == 0;
+    // Read-only files are mapped private: stray writes get their own pages instead of faulting
+    void* ptr = ok ? mmap(NULL, size, PROT_READ | PROT_WRITE, writable ? MAP_SHARED : MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    close(fd); // The mapping keeps the file open
+    return (ptr == MAP_FAILED) ? NULL : ptr;
+#endif
+}
+
+void sf_vmem_unmap_file(void* ptr, size_t size) {
+    if (!ptr) return;
+#ifdef _WIN32
+    (void)size;
+    UnmapViewOfFile(ptr);
+#else
+    munmap(ptr, size);
+#endif
+}
+
+void sf_vmem_advise(void* ptr, size_t size, sf_vmem_advice advice) {
+    if (!ptr || size == 0) return;
+#ifdef _WIN32
+    if (advice == SF_VMEM_ADVISE_WILLNEED) {
+        WIN32_MEMORY_RANGE_ENTRY range = { ptr, size };
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+#else
+    // Mappings are page aligned at the start; the kernel rounds the length
+    madvise(ptr, size, advice == SF_VMEM_ADVISE_SEQUENTIAL ? MADV_SEQUENTIAL : MADV_WILLNEED);
+#endif
+}
+
+bool sf_vmem_flush(void* ptr, size_t size) {
+    if (!ptr || size == 0) return true;
+#ifdef _WIN32
+    return FlushViewOfFile(ptr, size) != 0;
+#else
+    return msync(ptr, size, MS_SYNC) == 0;
+#endif
+}
+
+size_t sf_vmem_page_size(void) {
+    static size_t cached = 0;
+    if (cached) return cached;
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    cached = info.dwPageSize;
+#else
+    long sz = sysconf(_SC_PAGESIZE);
+    cached = sz > 0 ? (size_t)sz : 4096;
+#endif
+    return cached;
+}
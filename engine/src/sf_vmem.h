@@ -0,0 +1,80 @@
+#ifndef SF_VMEM_H
+#define SF_VMEM_H
+
+#include <sionflow/base/sf_types.h>
+
+/**
+ * Virtual memory helpers for engine backing stores.
+ * Reserved regions are readable/writable immediately, but physical pages are only
+ * committed when first touched, so large limits cost address space, not RSS.
+ * On Windows the first touch commits a chunk through a fault handler; ranges handed
+ * to the OS (file or socket I/O) must be committed first with sf_vmem_commit.
+ */
+
+/**
+ * @brief Reserves a lazily committed read/write region. Returns NULL on failure.
+ */
+void*   sf_vmem_reserve(size_t size);
+
+/**
+ * @brief Releases a region obtained from sf_vmem_reserve.
+ */
+void    sf_vmem_release(void* ptr, size_t size);
+
+/**
+ * @brief Commits a range of a reserved region ahead of use (Windows; no-op elsewhere).
+ * Returns false if the system commit limit is reached.
+ */
+bool    sf_vmem_commit(void* ptr, size_t size);
+
+/**
+ * @brief Returns the physical pages of a range to the OS. Contents become undefined (zero on Linux).
+ */
+void    sf_vmem_decommit(void* ptr, size_t size);
+
+/**
+ * @brief Maps a dedicated region for a large buffer, backed by huge pages when requested.
+ * mode is an sf_engine_page_mode. On POSIX the region starts on a 2MB boundary.
+ * The mapped size (rounded up) is written to out_size.
+ */
+void*   sf_vmem_map_large(size_t size, int mode, size_t* out_size);
+
+/**
+ * @brief Restricts a range to the given NUMA nodes (bitmask). No-op where unsupported.
+ * Pages are placed by policy on first touch, regardless of the touching thread.
+ */
+bool    sf_vmem_bind_numa(void* ptr, size_t size, u64 node_mask);
+
+typedef enum {
+    SF_VMEM_ADVISE_SEQUENTIAL, // Aggressive readahead, pages behind the cursor may be dropped
+    SF_VMEM_ADVISE_WILLNEED    // Start reading the range in now
+} sf_vmem_advice;
+
+/**
+ * @brief Maps size bytes of a file. Read-only mappings require the file to hold at least
+ * size bytes and are copy-on-write (writes stay private); writable ones are shared and
+ * create or grow the file. Returns NULL on failure.
+ */
+void*   sf_vmem_map_file(const char* path, size_t size, bool writable);
+
+/**
+ * @brief Unmaps a region obtained from sf_vmem_map_file (dirty pages still reach the file).
+ */
+void    sf_vmem_unmap_file(void* ptr, size_t size);
+
+/**
+ * @brief Access pattern hint for a file mapping. No-op where unsupported.
+ */
+void    sf_vmem_advise(void* ptr, size_t size, sf_vmem_advice advice);
+
+/**
+ * @brief Writes dirty pages of a writable file mapping back to the file.
+ */
+bool    sf_vmem_flush(void* ptr, size_t size);
+
+/**
+ * @brief System page size.
+ */
+size_t  sf_vmem_page_size(void);
+
+#endif // SF_VMEM_H
@@ -0,0 +1,115 @@
+#ifndef SF_ASYNC_LOG_H
+#define SF_ASYNC_LOG_H
+
+#include <sionflow/base/sf_types.h>
+#include <sionflow/base/sf_log.h>
+
+/**
+ * Asynchronous logging for hot paths (frame loops, workers).
+ *
+ * SF_ALOG_* captures the format pointer and its arguments (typed via _Generic, strings
+ * copied) into a per-thread lock-free ring; a background thread formats and writes them.
+ * When the level is disabled the cost is a single compare. When a ring is full the
+ * record is dropped (and counted), the caller never blocks. A thread's ring is recycled
+ * once the thread has exited and its records are written.
+ *
+ * Rules: the format must be a string literal (it is read later); at most
+ * SF_ALOG_MAX_ARGS arguments; '*' width/precision is not supported.
+ */
+
+#define SF_ALOG_MAX_ARGS     8
+#define SF_ALOG_STRING_BYTES 128 // Per record, for copies of string arguments
+
+typedef enum {
+    SF_ALOG_ARG_INT,
+    SF_ALOG_ARG_UINT,
+    SF_ALOG_ARG_FLOAT,
+    SF_ALOG_ARG_STR,    // Pointer (format) or offset into the record's string area
+    SF_ALOG_ARG_PTR
+} sf_alog_arg_type;
+
+typedef struct {
+    u8 type;
+    union {
+        long long          i;
+        unsigned long long u;
+        double             f;
+        const char*        s;
+        const void*        p;
+    } v;
+} sf_alog_arg;
+
+/** Records below this level are discarded at the call site. */
+extern volatile int sf_alog_level;
+
+/**
+ * @brief Starts the flusher thread writing to path (NULL = console only).
+ * Records at WARN and above are mirrored to stderr. Returns false if already running or on failure.
+ */
+bool    sf_alog_start(const char* path, sf_log_level level);
+
+/**
+ * @brief Flushes everything still queued and stops the flusher thread.
+ */
+void    sf_alog_stop(void);
+
+/**
+ * @brief Changes the capture level at runtime.
+ */
+void    sf_alog_set_level(sf_log_level level);
+
+/**
+ * @brief Number of records dropped because a ring was full (or no ring was free).
+ */
+u64     sf_alog_dropped(void);
+
+void    sf_alog_push(int level, const sf_alog_arg* args, u32 count);
+
+// --- Argument Capture ---
+
+static inline sf_alog_arg sf_alog_arg_i(long long v)          { sf_alog_arg a; a.type = SF_ALOG_ARG_INT;   a.v.i = v; return a; }
+static inline sf_alog_arg sf_alog_arg_u(unsigned long long v) { sf_alog_arg a; a.type = SF_ALOG_ARG_UINT;  a.v.u = v; return a; }
+static inline sf_alog_arg sf_alog_arg_f(double v)             { sf_alog_arg a; a.type = SF_ALOG_ARG_FLOAT; a.v.f = v; return a; }
+static inline sf_alog_arg sf_alog_arg_s(const char* v)        { sf_alog_arg a; a.type = SF_ALOG_ARG_STR;   a.v.s = v; return a; }
+static inline sf_alog_arg sf_alog_arg_p(const void* v)        { sf_alog_arg a; a.type = SF_ALOG_ARG_PTR;   a.v.p = v; return a; }
+
+#define SF_ALOG_ARG(x) _Generic((x), \
+    _Bool: sf_alog_arg_i, char: sf_alog_arg_i, signed char: sf_alog_arg_i, short: sf_alog_arg_i, \
+    int: sf_alog_arg_i, long: sf_alog_arg_i, long long: sf_alog_arg_i, \
+    unsigned char: sf_alog_arg_u, unsigned short: sf_alog_arg_u, unsigned int: sf_alog_arg_u, \
+    unsigned long: sf_alog_arg_u, unsigned long long: sf_alog_arg_u, \
+    float: sf_alog_arg_f, double: sf_alog_arg_f, long double: sf_alog_arg_f, \
+    char*: sf_alog_arg_s, const char*: sf_alog_arg_s, \
+    default: sf_alog_arg_p)(x)
+
+#define SF_ALOG_CAT_(a, b) a##b
+#define SF_ALOG_CAT(a, b) SF_ALOG_CAT_(a, b)
+#define SF_ALOG_NARGS_(_1, _2, _3, _4, _5, _6, _7, _8, _9, N, ...) N
+#define SF_ALOG_NARGS(...) SF_ALOG_NARGS_(__VA_ARGS__, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+
+#define SF_ALOG_MAP_1(a)      SF_ALOG_ARG(a)
+#define SF_ALOG_MAP_2(a, ...) SF_ALOG_ARG(a), SF_ALOG_MAP_1(__VA_ARGS__)
+#define SF_ALOG_MAP_3(a, ...) SF_ALOG_ARG(a), SF_ALOG_MAP_2(__VA_ARGS__)
+#define SF_ALOG_MAP_4(a, ...) SF_ALOG_ARG(a), SF_ALOG_MAP_3(__VA_ARGS__)
+#define SF_ALOG_MAP_5(a, ...) SF_ALOG_ARG(a), SF_ALOG_MAP_4(__VA_ARGS__)
+#define SF_ALOG_MAP_6(a, ...) SF_ALOG_ARG(a), SF_ALOG_MAP_5(__VA_ARGS__)
+#define SF_ALOG_MAP_7(a, ...) SF_ALOG_ARG(a), SF_ALOG_MAP_6(__VA_ARGS__)
+#define SF_ALOG_MAP_8(a, ...) SF_ALOG_ARG(a), SF_ALOG_MAP_7(__VA_ARGS__)
+#define SF_ALOG_MAP_9(a, ...) SF_ALOG_ARG(a), SF_ALOG_MAP_8(__VA_ARGS__)
+#define SF_ALOG_MAP(...) SF_ALOG_CAT(SF_ALOG_MAP_, SF_ALOG_NARGS(__VA_ARGS__))(__VA_ARGS__)
+
+// First captured argument is the format itself
+#define SF_ALOG(level, ...) do { \
+    if ((int)(level) >= sf_alog_level) { \
+        const sf_alog_arg sf_alog_args_[] = { SF_ALOG_MAP(__VA_ARGS__) }; \
+        sf_alog_push((int)(level), sf_alog_args_, (u32)(sizeof(sf_alog_args_) / sizeof(sf_alog_args_[0]))); \
+    } \
+} while (0)
+
+#define SF_ALOG_TRACE(...) SF_ALOG(SF_LOG_LEVEL_TRACE, __VA_ARGS__)
+#define SF_ALOG_DEBUG(...) SF_ALOG(SF_LOG_LEVEL_DEBUG, __VA_ARGS__)
+#define SF_ALOG_INFO(...)  SF_ALOG(SF_LOG_LEVEL_INFO, __VA_ARGS__)
+#define SF_ALOG_WARN(...)  SF_ALOG(SF_LOG_LEVEL_WARN, __VA_ARGS__)
+#define SF_ALOG_ERROR(...) SF_ALOG(SF_LOG_LEVEL_ERROR, __VA_ARGS__)
+
+#endif // SF_ASYNC_LOG_H
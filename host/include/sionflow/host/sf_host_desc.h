@@ -15,6 +15,7 @@ typedef struct {
     const char* resource_name;
     const char* path;
     float font_size; // only for fonts
+    uint64_t content_hash; // Hash of the stored section bytes (0 = unknown, always reloaded)
 } sf_host_asset;
 
 // Configuration for the Host Application
@@ -37,6 +38,53 @@ typedef struct sf_host_desc {
     // Optional: Number of worker threads (0 = Auto)
     int num_threads;
 
+    // Optional engine memory limits (0 = default). Address space is reserved, pages commit on use.
+    size_t arena_limit;
+    size_t heap_limit;
+
+    // Headless: print memory usage and an arena/heap sizing recommendation on exit
+    bool memory_report;
+
+    // Headless: profile kernels (wall time + hardware counters where permitted) and print a report
+    bool perf_report;
+    bool perf_per_task;
+
+    // Optional warm start / checkpoint (headless): restore after init, snapshot on exit
+    const char* restore_path;
+    const char* snapshot_path;
+
+    // Input recording (any host) and frame-exact replay (headless)
+    const char* record_path;
+    const char* replay_path;
+    float replay_fixed_dt; // Replay: > 0 replaces recorded timestamps with frame * dt
+
+    // Headless: render independent frames on several engines at once (clones of the first).
+    // Used when no kernel reads state written in an earlier frame (sf_engine_is_frame_independent).
+    int  render_engines;      // 0/1 = serial, < 0 = one per hardware thread
+    bool frames_independent;  // Skip the check: the caller guarantees frames are independent
+
+    // Render clones and service pools share the one backend and its state. Set when the backend's
+    // dispatch may run on several engines at once; without it, parallel rendering falls back to
+    // serial and the service steps one engine at a time.
+    bool backend_reentrant;
+
+    // Pipeline instances per engine (sf_engine_desc.batch_size, 0/1 = one). Inputs reach every
+    // instance unless the host sets them per instance.
+    uint32_t batch_size;
+
+    // SDL: target step time in ms. When exceeded, screen-size resources render at a reduced
+    // internal resolution and are upscaled on present. 0 = always render at window size.
+    float frame_budget_ms;
+    float min_render_scale; // Lower bound for the internal resolution scale (0 = 0.25)
+
+    // SDL: step the engine on its own thread at a fixed rate, decoupled from present/vsync
+    bool  threaded_sim;
+    float sim_rate_hz; // Fixed simulation rate (0 = 60)
+
+    // SDL: event-driven rendering. Block on events and only step when inputs change, a kernel
+    // reads u_Time, or a kernel writes nonzero to out_RequestFrame. Serial loop only.
+    bool  idle_mode;
+
     // Logging Interval (in seconds) for TRACE logs and screenshots. 0 = Disable periodic logging.
     float log_interval;
     
@@ -52,6 +100,12 @@ typedef struct sf_host_desc {
  */
 void sf_host_init_logger(void);
 
+/**
+ * @brief Drains the asynchronous log queues and stops the flusher thread.
+ * Also registered with atexit by sf_host_init_logger; safe to call more than once.
+ */
+void sf_host_shutdown_logger(void);
+
 /**
  * @brief Cleans up memory allocated within sf_host_desc (e.g. by manifest loader).
  */
@@ -3,6 +3,7 @@
 
 #include <sionflow/host/sf_host_desc.h>
 #include <sionflow/isa/sf_backend.h>
+#include <sionflow/isa/sf_tensor.h>
 
 /**
  * @brief Runs the engine in headless mode (CLI).
@@ -16,4 +17,21 @@
  */
 int sf_host_run_headless(const sf_host_desc* desc, sf_backend backend, int frames);
 
+/**
+ * @brief Receives one rendered frame. output describes the cartridge's output resource
+ * and is only valid for the duration of the call.
+ */
+typedef void (*sf_host_frame_sink)(u32 frame, const sf_tensor* output, void* user_data);
+
+/**
+ * @brief Renders frames [first_frame, first_frame + frame_count) offline, with u_Time = frame * dt
+ * (dt 0 = 0.016), and passes each output to sink in frame order.
+ * Frames are spread over desc->render_engines engines when they are independent and the backend
+ * is marked reentrant (desc->backend_reentrant); results are reordered before reaching the sink,
+ * so it always runs on the calling thread in sequence. Recording forces serial rendering.
+ * @return int Exit code (0 on success).
+ */
+int sf_host_render_frames(const sf_host_desc* desc, sf_backend backend, u32 first_frame, u32 frame_count, f32 dt,
+                          sf_host_frame_sink sink, void* user_data);
+
 #endif // SF_HOST_HEADLESS_H
@@ -0,0 +1,108 @@
+#ifndef SF_HOST_SERVICE_H
+#define SF_HOST_SERVICE_H
+
+#include <sionflow/host/sf_host_desc.h>
+#include <sionflow/isa/sf_backend.h>
+
+/**
+ * Local render service (POSIX only).
+ *
+ * Listens on a Unix domain socket (SOCK_SEQPACKET, one message per request/reply) and
+ * serves "set inputs, run N frames, return resources" requests from pools of engines
+ * that are created, loaded and bound once per cartridge. Each request starts from the
+ * cartridge's initial state unless it sets SF_SERVICE_FLAG_CONTINUE.
+ *
+ * Request message:
+ *   sf_service_request
+ *   cartridge manifest path (cartridge_len bytes, no terminator; 0 = default cartridge)
+ *   input_count x { sf_service_input, payload padded to 8 bytes }
+ *   output_count x sf_service_name
+ *
+ * Reply message:
+ *   sf_service_reply
+ *   output_count x sf_service_output
+ *   + SCM_RIGHTS shared-memory fd (when shm_bytes > 0) holding the output payloads.
+ *     The client maps it read-only and closes it when done; the service keeps no reference.
+ */
+
+#define SF_SERVICE_REQUEST_MAGIC 0x51524653u // "SFRQ"
+#define SF_SERVICE_REPLY_MAGIC   0x50524653u // "SFRP"
+#define SF_SERVICE_VERSION       1u
+#define SF_SERVICE_NAME_LEN      64u
+#define SF_SERVICE_MAX_MESSAGE   (64u * 1024u)
+#define SF_SERVICE_SHM_ALIGN     64u
+
+typedef enum {
+    SF_SERVICE_OK = 0,
+    SF_SERVICE_ERR_BAD_REQUEST,
+    SF_SERVICE_ERR_CARTRIDGE,    // Manifest failed to load or pool could not be created
+    SF_SERVICE_ERR_ENGINE,       // Engine error while stepping
+    SF_SERVICE_ERR_SHM           // Shared memory for the reply could not be created
+} sf_service_status;
+
+typedef enum {
+    SF_SERVICE_FLAG_REWIND   = 1 << 0, // Start from the cartridge's initial state (the default; kept for older clients)
+    SF_SERVICE_FLAG_CONTINUE = 1 << 1  // Start from the pooled engine's last state. Which engine serves a request
+                                       // is unspecified, so only useful with a pool of one or stateless pipelines
+} sf_service_flags;
+
+typedef struct {
+    u32 magic;
+    u32 version;
+    u32 flags;          // SF_SERVICE_FLAG_*
+    u32 frames;         // Frames to step (0 = only read outputs)
+    u32 cartridge_len;
+    f32 time;           // Time of the first frame
+    f32 dt;             // Added per frame
+    i32 width;          // 0 = keep the cartridge's size
+    i32 height;
+    f32 mouse[4];       // x, y, lmb, rmb
+    u32 input_count;
+    u32 output_count;
+} sf_service_request;
+
+typedef struct {
+    char name[SF_SERVICE_NAME_LEN];
+} sf_service_name;
+
+/** Raw bytes written into a resource before the first frame (truncated to its size). */
+typedef struct {
+    char name[SF_SERVICE_NAME_LEN];
+    u32  bytes;
+    u32  reserved;
+} sf_service_input;
+
+typedef struct {
+    u32 magic;
+    u32 status;         // sf_service_status
+    u32 frames;         // Frames actually stepped
+    u32 output_count;
+    u64 shm_bytes;
+} sf_service_reply;
+
+/** Outputs the engine does not know are returned with ndim = 0 and bytes = 0. */
+typedef struct {
+    char name[SF_SERVICE_NAME_LEN];
+    u32  dtype;
+    u32  ndim;
+    i32  shape[SF_MAX_DIMS];
+    u64  offset;        // Into the shared memory
+    u64  bytes;
+} sf_service_output;
+
+typedef struct {
+    const char* socket_path;
+    u32 pool_size;       // Engines per cartridge (0 = 2)
+    u32 worker_count;    // Request workers (0 = pool_size); idle connections don't hold one
+    u32 max_cartridges;  // Distinct cartridges kept warm (0 = 8)
+} sf_host_service_desc;
+
+/**
+ * @brief Runs the render service until SIGINT/SIGTERM.
+ * The default cartridge (desc) is pooled up front; requests naming another manifest
+ * create its pool on first use.
+ * @return int Exit code (0 on clean shutdown).
+ */
+int sf_host_run_service(const sf_host_desc* desc, const sf_host_service_desc* service, sf_backend backend);
+
+#endif // SF_HOST_SERVICE_H
@@ -27,13 +27,22 @@ bool sf_loader_load_image(sf_engine* engine, const char* name, const char* path)
     if (strcmp(ext, "sfc") == 0 || strcmp(ext, "bin") == 0) {
         sf_cartridge* cart = sf_cartridge_open(path);
         if (cart) {
+            // The section holds an encoded image: decode it into scratch (not the cartridge's cache)
             size_t section_size = 0;
-            void* section_data = sf_cartridge_get_section(cart, name, SF_SECTION_IMAGE, &section_size);
+            void* section_data = NULL;
+            if (sf_cartridge_section_size(cart, name, SF_SECTION_IMAGE, &section_size) && section_size <= INT32_MAX) {
+                section_data = malloc(section_size ? section_size : 1);
+                if (section_data && !sf_cartridge_read_section(cart, name, SF_SECTION_IMAGE, section_data, section_size)) {
+                    free(section_data);
+                    section_data = NULL;
+                }
+            }
+            sf_cartridge_close(cart);
             if (section_data) {
                 data = stbi_load_from_memory(section_data, (int)section_size, &w, &h, &c, d);
                 if (data) SF_LOG_INFO("Loaded embedded image '%s' from cartridge.", name);
+                free(section_data);
             }
-            sf_cartridge_close(cart);
         }
     }
 
@@ -83,6 +92,7 @@ bool sf_loader_load_image(sf_engine* engine, const char* name, const char* path)
     }
     
     stbi_image_free(data); 
+    sf_engine_broadcast_instance(engine, name);
     sf_engine_sync_resource(engine, name); 
     return true;
 }
@@ -117,14 +127,18 @@ bool sf_loader_load_font(sf_engine* engine, const char* name, const char* path,
     if (strcmp(ext, "sfc") == 0 || strcmp(ext, "bin") == 0) {
         sf_cartridge* cart = sf_cartridge_open(path);
         if (cart) {
+            // Decoded straight into the buffer stb_truetype keeps using
             size_t section_size = 0;
-            void* section_data = sf_cartridge_get_section(cart, name, SF_SECTION_FONT, &section_size);
-            if (section_data) {
-                ttf = malloc(section_size);
-                memcpy(ttf, section_data, section_size);
-                len = section_size;
-                ttf_owned = true;
-                SF_LOG_INFO("Loaded embedded font '%s' from cartridge.", name);
+            if (sf_cartridge_section_size(cart, name, SF_SECTION_FONT, &section_size)) {
+                ttf = malloc(section_size ? section_size : 1);
+                if (ttf && sf_cartridge_read_section(cart, name, SF_SECTION_FONT, ttf, section_size)) {
+                    len = section_size;
+                    ttf_owned = true;
+                    SF_LOG_INFO("Loaded embedded font '%s' from cartridge.", name);
+                } else {
+                    free(ttf);
+                    ttf = NULL;
+                }
             }
             sf_cartridge_close(cart);
         }
@@ -160,6 +174,7 @@ bool sf_loader_load_font(sf_engine* engine, const char* name, const char* path,
         sf_tensor* t = sf_engine_map_resource(engine, name); 
         if (t && t->buffer && t->buffer->data && t->info.dtype == SF_DTYPE_F32) {
             for(size_t i=0; i<(size_t)atlas_w*atlas_h; ++i) ((f32*)t->buffer->data)[i] = (f32)a[i] / 255.0f;
+            sf_engine_broadcast_instance(engine, name);
             sf_engine_sync_resource(engine, name);
         } else {
             SF_LOG_ERROR("Assets: Font resource '%s' must be F32.", name);
@@ -176,6 +191,7 @@ bool sf_loader_load_font(sf_engine* engine, const char* name, const char* path,
              size_t needed = max_glyphs * 8 * sizeof(f32);
              if (max_bytes >= needed) {
                  memcpy(ti->buffer->data, inf, needed);
+                 sf_engine_broadcast_instance(engine, in);
                  sf_engine_sync_resource(engine, in);
              } else {
                  SF_LOG_ERROR("Assets: Font info resource '%s' is too small.", in);
@@ -0,0 +1,346 @@
+#include <sionflow/host/sf_async_log.h>
+#include <sionflow/engine/sf_thread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#define SF_THREAD_LOCAL __declspec(thread)
+#else
+#include <pthread.h>
+#include <unistd.h>
+#define SF_THREAD_LOCAL _Thread_local
+#endif
+
+#define SF_ALOG_RING_SIZE   256u // Records per thread, power of two
+#define SF_ALOG_MAX_THREADS 64u  // Threads logging at the same time; rings are recycled on thread exit
+#define SF_ALOG_IDLE_MS     2u
+#define SF_ALOG_LINE_BYTES  1024u
+
+typedef struct {
+    u64         time_ns;   // Capture time, relative to sf_alog_start
+    int         level;
+    u32         arg_count; // Including the format
+    sf_alog_arg args[SF_ALOG_MAX_ARGS + 1];
+    char        strings[SF_ALOG_STRING_BYTES];
+} sf_alog_record;
+
+// Ring slot lifecycle: a thread claims a free slot, its exit retires it, and the
+// flusher frees it again once everything the thread pushed has been written
+#define SF_ALOG_SLOT_FREE    0
+#define SF_ALOG_SLOT_OWNED   1
+#define SF_ALOG_SLOT_RETIRED 2
+
+/** Single-producer (owning thread) / single-consumer (flusher) ring. */
+typedef struct {
+    sf_alog_record records[SF_ALOG_RING_SIZE];
+    sf_atomic_i32   head;
+    sf_atomic_i32   tail;
+    sf_atomic_i32   dropped;
+    u32            thread_no;
+} sf_alog_ring;
+
+static struct {
+    sf_alog_ring* volatile rings[SF_ALOG_MAX_THREADS]; // Kept once allocated, reused by later threads
+    sf_atomic_i32  slot_state[SF_ALOG_MAX_THREADS];    // SF_ALOG_SLOT_*
+    sf_atomic_i32  thread_seq;   // Numbers threads in the output
+    sf_atomic_i32  running;
+    sf_atomic_i32  dropped_no_ring;
+    u64           dropped_total;
+    sf_thread*    flusher;
+    FILE*         file;
+    u64           start_ns;
+} g_alog;
+
+volatile int sf_alog_level = SF_LOG_LEVEL_FATAL + 1; // Disabled until started
+
+static SF_THREAD_LOCAL sf_alog_ring* t_ring;
+static SF_THREAD_LOCAL bool t_ring_failed;
+
+static u64 _now_ns(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (u64)ts.tv_sec * 1000000000ull + (u64)ts.tv_nsec;
+}
+
+static void _sleep_ms(u32 ms) {
+#ifdef _WIN32
+    Sleep(ms);
+#else
+    usleep(ms * 1000u);
+#endif
+}
+
+// --- Producer Side ---
+
+// Runs on the exiting thread: later pushes from it (other destructors) are dropped
+static void _ring_retire(void* ring) {
+    if (!ring || ring != t_ring) return;
+    for (u32 i = 0; i < SF_ALOG_MAX_THREADS; ++i) {
+        if (g_alog.rings[i] == ring) sf_atomic_store(&g_alog.slot_state[i], SF_ALOG_SLOT_RETIRED);
+    }
+    t_ring = NULL;
+    t_ring_failed = true;
+}
+
+#ifdef _WIN32
+static DWORD g_ring_key = FLS_OUT_OF_INDEXES;
+static INIT_ONCE g_ring_once = INIT_ONCE_STATIC_INIT;
+
+static void WINAPI _ring_exit(void* ring) { _ring_retire(ring); }
+
+static BOOL CALLBACK _ring_key_init(PINIT_ONCE once, void* param, void** ctx) {
+    (void)once; (void)param; (void)ctx;
+    g_ring_key = FlsAlloc(_ring_exit);
+    return TRUE;
+}
+
+static bool _ring_watch_exit(sf_alog_ring* ring) {
+    InitOnceExecuteOnce(&g_ring_once, _ring_key_init, NULL, NULL);
+    return g_ring_key != FLS_OUT_OF_INDEXES && FlsSetValue(g_ring_key, ring);
+}
+#else
+static pthread_key_t g_ring_key;
+static pthread_once_t g_ring_once = PTHREAD_ONCE_INIT;
+static bool g_ring_key_ok;
+
+static void _ring_key_init(void) {
+    g_ring_key_ok = pthread_key_create(&g_ring_key, _ring_retire) == 0;
+}
+
+static bool _ring_watch_exit(sf_alog_ring* ring) {
+    pthread_once(&g_ring_once, _ring_key_init);
+    return g_ring_key_ok && pthread_setspecific(g_ring_key, ring) == 0;
+}
+#endif
+
+static sf_alog_ring* _thread_ring(void) {
+    if (t_ring || t_ring_failed) return t_ring;
+    for (u32 slot = 0; slot < SF_ALOG_MAX_THREADS; ++slot) {
+        if (!sf_atomic_i32_compare_exchange(&g_alog.slot_state[slot], SF_ALOG_SLOT_FREE, SF_ALOG_SLOT_OWNED)) continue;
+        // A recycled ring was fully drained before its slot was freed; head and tail carry on
+        sf_alog_ring* ring = g_alog.rings[slot];
+        if (!ring) ring = calloc(1, sizeof(sf_alog_ring));
+        if (!ring) {
+            sf_atomic_store(&g_alog.slot_state[slot], SF_ALOG_SLOT_FREE);
+            break;
+        }
+        ring->thread_no = (u32)sf_atomic_i32_fetch_add(&g_alog.thread_seq, 1);
+        g_alog.rings[slot] = ring;
+        t_ring = ring;
+        // Without an exit hook the slot stays with this thread for good
+        _ring_watch_exit(ring);
+        return ring;
+    }
+    t_ring_failed = true;
+    return NULL;
+}
+
+void sf_alog_push(int level, const sf_alog_arg* args, u32 count) {
+    sf_alog_ring* ring = _thread_ring();
+    if (!ring) {
+        sf_atomic_i32_fetch_add(&g_alog.dropped_no_ring, 1);
+        return;
+    }
+    u32 head = (u32)sf_atomic_load(&ring->head);
+    if (head - (u32)sf_atomic_load(&ring->tail) >= SF_ALOG_RING_SIZE) {
+        sf_atomic_i32_fetch_add(&ring->dropped, 1);
+        return;
+    }
+
+    sf_alog_record* r = &ring->records[head & (SF_ALOG_RING_SIZE - 1)];
+    r->time_ns = _now_ns() - g_alog.start_ns;
+    r->level = level;
+    r->arg_count = count > SF_ALOG_MAX_ARGS + 1 ? SF_ALOG_MAX_ARGS + 1 : count;
+
+    // Strings may not outlive the call: copy them (the format is a literal and is kept as is)
+    size_t used = 0;
+    for (u32 i = 0; i < r->arg_count; ++i) {
+        r->args[i] = args[i];
+        if (i == 0 || args[i].type != SF_ALOG_ARG_STR) continue;
+        const char* s = args[i].v.s ? args[i].v.s : "(null)";
+        size_t len = strlen(s);
+        if (used + len + 1 > SF_ALOG_STRING_BYTES) len = (used < SF_ALOG_STRING_BYTES) ? SF_ALOG_STRING_BYTES - used - 1 : 0;
+        if (used < SF_ALOG_STRING_BYTES) {
+            memcpy(r->strings + used, s, len);
+            r->strings[used + len] = '\0';
+            r->args[i].v.u = used;
+            used += len + 1;
+        } else {
+            r->args[i].v.u = SF_ALOG_STRING_BYTES - 1; // Points at the last terminator
+        }
+    }
+    sf_atomic_store(&ring->head, head + 1);
+}
+
+// --- Consumer Side ---
+
+static size_t _append(char* out, size_t pos, size_t cap, const char* text, size_t len) {
+    if (pos >= cap) return pos;
+    if (len > cap - pos - 1) len = cap - pos - 1;
+    memcpy(out + pos, text, len);
+    out[pos + len] = '\0';
+    return pos + len;
+}
+
+/**
+ * Re-runs the captured printf format one conversion at a time. Length modifiers in the
+ * format are replaced by the ones matching the captured (widened) argument type.
+ */
+static void _format(const sf_alog_record* r, char* out, size_t cap) {
+    const char* fmt = r->args[0].v.s;
+    u32 next = 1;
+    size_t pos = 0;
+    out[0] = '\0';
+
+    while (fmt && *fmt && pos + 1 < cap) {
+        const char* pct = strchr(fmt, '%');
+        if (!pct) { pos = _append(out, pos, cap, fmt, strlen(fmt)); break; }
+        pos = _append(out, pos, cap, fmt, (size_t)(pct - fmt));
+        if (pct[1] == '%') { pos = _append(out, pos, cap, "%", 1); fmt = pct + 2; continue; }
+
+        // %[flags][width][.precision][length]conv
+        char spec[32];
+        size_t n = 0;
+        const char* p = pct;
+        spec[n++] = *p++;
+        while (*p && strchr("-+ #0123456789.", *p) && n < sizeof(spec) - 4) spec[n++] = *p++;
+        while (*p && strchr("hlLqjzt", *p)) p++;
+        char conv = *p ? *p++ : '\0';
+        fmt = p;
+        if (!conv) break;
+
+        if (next >= r->arg_count) { pos = _append(out, pos, cap, "<?>", 3); continue; }
+        const sf_alog_arg* a = &r->args[next++];
+        char piece[256];
+        int len = 0;
+
+        if (strchr("di", conv)) {
+            spec[n++] = 'l'; spec[n++] = 'l'; spec[n++] = conv; spec[n] = '\0';
+            long long v = (a->type == SF_ALOG_ARG_FLOAT) ? (long long)a->v.f : a->v.i;
+            len = snprintf(piece, sizeof(piece), spec, v);
+        } else if (strchr("uxXo", conv)) {
+            spec[n++] = 'l'; spec[n++] = 'l'; spec[n++] = conv; spec[n] = '\0';
+            unsigned long long v = (a->type == SF_ALOG_ARG_FLOAT) ? (unsigned long long)a->v.f : a->v.u;
+            len = snprintf(piece, sizeof(piece), spec, v);
+        } else if (strchr("fFeEgGaA", conv)) {
+            spec[n++] = conv; spec[n] = '\0';
+            double v = (a->type == SF_ALOG_ARG_FLOAT) ? a->v.f : (a->type == SF_ALOG_ARG_UINT) ? (double)a->v.u : (double)a->v.i;
+            len = snprintf(piece, sizeof(piece), spec, v);
+        } else if (conv == 'c') {
+            spec[n++] = conv; spec[n] = '\0';
+            len = snprintf(piece, sizeof(piece), spec, (int)a->v.i);
+        } else if (conv == 's') {
+            spec[n++] = conv; spec[n] = '\0';
+            const char* s = (a->type == SF_ALOG_ARG_STR) ? r->strings + a->v.u : "<?>";
+            len = snprintf(piece, sizeof(piece), spec, s);
+        } else if (conv == 'p') {
+            len = snprintf(piece, sizeof(piece), "%p", a->v.p);
+        } else {
+            piece[0] = '%'; piece[1] = conv; len = 2;
+        }
+        if (len > 0) pos = _append(out, pos, cap, piece, (size_t)len < sizeof(piece) ? (size_t)len : sizeof(piece) - 1);
+    }
+}
+
+static const char* _level_name(int level) {
+    switch (level) {
+        case SF_LOG_LEVEL_TRACE: return "TRACE";
+        case SF_LOG_LEVEL_DEBUG: return "DEBUG";
+        case SF_LOG_LEVEL_INFO:  return "INFO";
+        case SF_LOG_LEVEL_WARN:  return "WARN";
+        case SF_LOG_LEVEL_ERROR: return "ERROR";
+        default:                 return "FATAL";
+    }
+}
+
+static void _emit_line(int level, u64 time_ns, u32 thread_no, const char* text) {
+    char prefix[64];
+    snprintf(prefix, sizeof(prefix), "[%10.4f] [T%02u] [%-5s] ", (double)time_ns / 1.0e9, thread_no, _level_name(level));
+    if (g_alog.file) fprintf(g_alog.file, "%s%s\n", prefix, text);
+    if (level >= SF_LOG_LEVEL_WARN) fprintf(stderr, "%s%s\n", prefix, text);
+}
+
+static u32 _drain(void) {
+    char line[SF_ALOG_LINE_BYTES];
+    u32 total = 0;
+
+    for (u32 i = 0; i < SF_ALOG_MAX_THREADS; ++i) {
+        sf_alog_ring* ring = g_alog.rings[i];
+        if (!ring) continue; // Slot never used, or its ring not published yet
+        // Read before draining: once retired, the owner pushes nothing more
+        bool retired = sf_atomic_load(&g_alog.slot_state[i]) == SF_ALOG_SLOT_RETIRED;
+
+        u32 tail = (u32)sf_atomic_load(&ring->tail);
+        u32 head = (u32)sf_atomic_load(&ring->head);
+        for (; tail != head; ++tail, ++total) {
+            const sf_alog_record* r = &ring->records[tail & (SF_ALOG_RING_SIZE - 1)];
+            _format(r, line, sizeof(line));
+            _emit_line(r->level, r->time_ns, ring->thread_no, line);
+        }
+        sf_atomic_store(&ring->tail, tail);
+
+        u32 dropped = (u32)sf_atomic_load(&ring->dropped);
+        if (dropped) {
+            sf_atomic_i32_fetch_add(&ring->dropped, -(i32)dropped);
+            g_alog.dropped_total += dropped;
+            snprintf(line, sizeof(line), "Async log: dropped %u records (ring full)", dropped);
+            _emit_line(SF_LOG_LEVEL_WARN, _now_ns() - g_alog.start_ns, ring->thread_no, line);
+        }
+        if (retired) sf_atomic_store(&g_alog.slot_state[i], SF_ALOG_SLOT_FREE);
+    }
+    if (total && g_alog.file) fflush(g_alog.file);
+    return total;
+}
+
+static void _flusher(void* user_data) {
+    (void)user_data;
+    while ((u32)sf_atomic_load(&g_alog.running)) {
+        if (_drain() == 0) _sleep_ms(SF_ALOG_IDLE_MS);
+    }
+    _drain();
+}
+
+// --- Control ---
+
+bool sf_alog_start(const char* path, sf_log_level level) {
+    if ((u32)sf_atomic_load(&g_alog.running)) return false;
+    g_alog.start_ns = _now_ns();
+    g_alog.file = NULL;
+    if (path) {
+        g_alog.file = fopen(path, "a");
+        if (!g_alog.file) SF_LOG_ERROR("Async log: cannot open '%s', console only", path);
+    }
+    sf_atomic_store(&g_alog.running, 1);
+    g_alog.flusher = sf_thread_start(_flusher, NULL);
+    if (!g_alog.flusher) {
+        sf_atomic_store(&g_alog.running, 0);
+        if (g_alog.file) fclose(g_alog.file);
+        g_alog.file = NULL;
+        return false;
+    }
+    sf_alog_level = (int)level;
+    return true;
+}
+
+void sf_alog_stop(void) {
+    if (!(u32)sf_atomic_load(&g_alog.running)) return;
+    sf_alog_level = SF_LOG_LEVEL_FATAL + 1;
+    sf_atomic_store(&g_alog.running, 0);
+    sf_thread_join(g_alog.flusher);
+    g_alog.flusher = NULL;
+    if (g_alog.file) fclose(g_alog.file);
+    g_alog.file = NULL;
+    // Rings stay allocated: their owning threads may still hold them
+}
+
+void sf_alog_set_level(sf_log_level level) {
+    if ((u32)sf_atomic_load(&g_alog.running)) sf_alog_level = (int)level;
+}
+
+u64 sf_alog_dropped(void) {
+    return g_alog.dropped_total + (u32)sf_atomic_load(&g_alog.dropped_no_ring);
+}
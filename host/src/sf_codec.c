@@ -0,0 +1,279 @@
+#include "sf_codec.h"
+#include <sionflow/engine/sf_thread.h>
+#include <sionflow/base/sf_log.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Section layout (host byte order):
+ *   sf_codec_header
+ *   sf_codec_block[block_count]
+ *   packed blocks, at the offsets in the table (relative to the section start)
+ *
+ * Block stream: sequences of
+ *   token (literal length << 4 | match length - 4), each nibble extended by 255-runs when 15
+ *   literals
+ *   u16 match offset, then the match length extension
+ * The last sequence carries literals only. Offsets never reach outside the block.
+ */
+
+#define SF_LZ_MIN_MATCH  4u
+#define SF_LZ_MAX_OFFSET 65535u
+#define SF_LZ_HASH_BITS  14u
+#define SF_LZ_TAIL       12u // Trailing bytes always emitted as literals
+
+typedef struct {
+    u32 magic;
+    u32 block_size;
+    u64 raw_size;
+    u32 block_count;
+    u32 reserved;
+} sf_codec_header;
+
+typedef struct {
+    u32 offset;
+    u32 packed_size;  // == raw_size: block is stored uncompressed
+    u32 raw_size;
+    u32 checksum;     // Of the decoded bytes
+} sf_codec_block;
+
+static u32 _checksum(const u8* p, size_t n) {
+    u64 h = 0x9E3779B97F4A7C15ull ^ (u64)n;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        u64 w;
+        memcpy(&w, p + i, 8);
+        h = (h ^ w) * 0xff51afd7ed558ccdull;
+        h ^= h >> 29;
+    }
+    for (; i < n; ++i) h = (h ^ p[i]) * 0x100000001b3ull;
+    h ^= h >> 33;
+    return (u32)h ^ (u32)(h >> 32);
+}
+
+static u32 _read32(const u8* p) {
+    u32 v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+// --- Decoding ---
+
+static bool _read_length(const u8** ip, const u8* iend, size_t* len) {
+    u8 b;
+    do {
+        if (*ip >= iend) return false;
+        b = *(*ip)++;
+        *len += b;
+    } while (b == 255);
+    return true;
+}
+
+static bool _lz_decode(const u8* src, size_t src_len, u8* dst, size_t dst_len) {
+    const u8* ip = src;
+    const u8* iend = src + src_len;
+    u8* op = dst;
+    u8* oend = dst + dst_len;
+
+    while (ip < iend) {
+        u32 token = *ip++;
+        size_t lit = token >> 4;
+        if (lit == 15 && !_read_length(&ip, iend, &lit)) return false;
+        if ((size_t)(iend - ip) < lit || (size_t)(oend - op) < lit) return false;
+        memcpy(op, ip, lit);
+        op += lit;
+        ip += lit;
+        if (ip == iend) break;
+
+        if (iend - ip < 2) return false;
+        size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (size_t)(op - dst)) return false;
+
+        size_t len = token & 15;
+        if (len == 15 && !_read_length(&ip, iend, &len)) return false;
+        len += SF_LZ_MIN_MATCH;
+        if ((size_t)(oend - op) < len) return false;
+
+        const u8* match = op - offset;
+        if (offset >= len) {
+            memcpy(op, match, len);
+        } else {
+            for (size_t i = 0; i < len; ++i) op[i] = match[i]; // Overlapping run
+        }
+        op += len;
+    }
+    return op == oend;
+}
+
+static bool _read_table(const void* data, size_t size, sf_codec_header* head, const u8** table) {
+    if (!data || size < sizeof(sf_codec_header)) return false;
+    memcpy(head, data, sizeof(sf_codec_header));
+    if (head->magic != SF_CODEC_MAGIC || head->block_size == 0) return false;
+
+    u64 expected_blocks = (head->raw_size + head->block_size - 1) / head->block_size;
+    if (head->block_count != expected_blocks) return false;
+    if ((u64)sizeof(sf_codec_header) + (u64)head->block_count * sizeof(sf_codec_block) > size) return false;
+    *table = (const u8*)data + sizeof(sf_codec_header);
+
+    for (u32 i = 0; i < head->block_count; ++i) {
+        sf_codec_block b;
+        memcpy(&b, *table + (size_t)i * sizeof(b), sizeof(b));
+        u64 raw = (i + 1 < head->block_count) ? head->block_size : head->raw_size - (u64)i * head->block_size;
+        if (b.raw_size != raw || b.packed_size > b.raw_size) return false;
+        if ((u64)b.offset + b.packed_size > size) return false;
+    }
+    return true;
+}
+
+bool sf_codec_check(const void* data, size_t size) {
+    u32 magic = 0;
+    if (!data || size < sizeof(magic)) return false;
+    memcpy(&magic, data, sizeof(magic));
+    return magic == SF_CODEC_MAGIC;
+}
+
+bool sf_codec_raw_size(const void* data, size_t size, size_t* out_raw_size) {
+    sf_codec_header head;
+    const u8* table;
+    if (!_read_table(data, size, &head, &table) || head.raw_size > SIZE_MAX) return false;
+    if (out_raw_size) *out_raw_size = (size_t)head.raw_size;
+    return true;
+}
+
+typedef struct {
+    const u8*    data;
+    const u8*    table;
+    u8*          dst;
+    u32          block_size;
+    sf_atomic_i32 failed;
+} sf_codec_job;
+
+static void _decode_block(void* ctx, u32 index) {
+    sf_codec_job* job = (sf_codec_job*)ctx;
+    if ((u32)sf_atomic_load(&job->failed)) return;
+
+    sf_codec_block b;
+    memcpy(&b, job->table + (size_t)index * sizeof(b), sizeof(b));
+    const u8* src = job->data + b.offset;
+    u8* dst = job->dst + (size_t)index * job->block_size;
+
+    bool ok = (b.packed_size == b.raw_size) ? (memcpy(dst, src, b.raw_size), true) : _lz_decode(src, b.packed_size, dst, b.raw_size);
+    if (!ok || _checksum(dst, b.raw_size) != b.checksum) {
+        SF_LOG_ERROR("Codec: Block %u is corrupt.", index);
+        sf_atomic_store(&job->failed, 1);
+    }
+}
+
+bool sf_codec_decode(const void* data, size_t size, void* dst, size_t dst_size, u32 max_threads) {
+    sf_codec_header head;
+    sf_codec_job job = {0};
+    if (!dst || !_read_table(data, size, &head, &job.table) || head.raw_size != dst_size) return false;
+
+    job.data = (const u8*)data;
+    job.dst = (u8*)dst;
+    job.block_size = head.block_size;
+    sf_parallel_for(head.block_count, max_threads, _decode_block, &job);
+    return !sf_atomic_load(&job.failed);
+}
+
+// --- Encoding ---
+
+static bool _write_length(u8** op, u8* oend, size_t len) {
+    for (; len >= 255; len -= 255) {
+        if (*op >= oend) return false;
+        *(*op)++ = 255;
+    }
+    if (*op >= oend) return false;
+    *(*op)++ = (u8)len;
+    return true;
+}
+
+static bool _emit(u8** op, u8* oend, const u8* lit, size_t lit_len, size_t offset, size_t match_len) {
+    if (*op >= oend) return false;
+    u8* token = (*op)++;
+    *token = (u8)((lit_len >= 15 ? 15 : lit_len) << 4);
+    if (lit_len >= 15 && !_write_length(op, oend, lit_len - 15)) return false;
+    if ((size_t)(oend - *op) < lit_len) return false;
+    memcpy(*op, lit, lit_len);
+    *op += lit_len;
+    if (match_len == 0) return true;
+
+    if (oend - *op < 2) return false;
+    *(*op)++ = (u8)(offset & 0xFF);
+    *(*op)++ = (u8)(offset >> 8);
+    size_t code = match_len - SF_LZ_MIN_MATCH;
+    *token |= (u8)(code >= 15 ? 15 : code);
+    if (code >= 15 && !_write_length(op, oend, code - 15)) return false;
+    return true;
+}
+
+// Returns the packed size, or 0 when the block does not shrink
+static size_t _lz_encode(const u8* src, size_t n, u8* dst, size_t cap, u32* table) {
+    memset(table, 0, sizeof(u32) << SF_LZ_HASH_BITS);
+    u8* op = dst;
+    u8* oend = dst + cap;
+    size_t anchor = 0;
+    size_t limit = n > SF_LZ_TAIL ? n - SF_LZ_TAIL : 0;
+
+    for (size_t i = 0; i < limit;) {
+        u32 seq = _read32(src + i);
+        u32 h = (seq * 2654435761u) >> (32 - SF_LZ_HASH_BITS);
+        size_t cand = table[h]; // Position + 1
+        table[h] = (u32)(i + 1);
+        if (!cand || i - (cand - 1) > SF_LZ_MAX_OFFSET || _read32(src + cand - 1) != seq) {
+            i++;
+            continue;
+        }
+
+        size_t m = cand - 1;
+        size_t len = SF_LZ_MIN_MATCH;
+        while (i + len < n && src[m + len] == src[i + len]) len++;
+        if (!_emit(&op, oend, src + anchor, i - anchor, i - m, len)) return 0;
+        i += len;
+        anchor = i;
+    }
+    if (!_emit(&op, oend, src + anchor, n - anchor, 0, 0)) return 0;
+    return (size_t)(op - dst);
+}
+
+void* sf_codec_encode(const void* src, size_t size, u32 block_size, size_t* out_size) {
+    if (!src && size) return NULL;
+    if (block_size == 0) block_size = SF_CODEC_BLOCK_SIZE;
+
+    u64 block_count = ((u64)size + block_size - 1) / block_size;
+    size_t table_end = sizeof(sf_codec_header) + (size_t)block_count * sizeof(sf_codec_block);
+    // Worst case: every block stored raw
+    if ((u64)table_end + size > UINT32_MAX) return NULL;
+    u8* out = malloc(table_end + size);
+    u32* hash = malloc(sizeof(u32) << SF_LZ_HASH_BITS);
+    if (!out || !hash) {
+        free(out);
+        free(hash);
+        return NULL;
+    }
+
+    sf_codec_header head = { SF_CODEC_MAGIC, block_size, (u64)size, (u32)block_count, 0 };
+    memcpy(out, &head, sizeof(head));
+
+    size_t pos = table_end;
+    for (u32 i = 0; i < (u32)block_count; ++i) {
+        const u8* raw = (const u8*)src + (size_t)i * block_size;
+        size_t raw_size = size - (size_t)i * block_size;
+        if (raw_size > block_size) raw_size = block_size;
+
+        sf_codec_block b = { (u32)pos, 0, (u32)raw_size, _checksum(raw, raw_size) };
+        size_t packed = _lz_encode(raw, raw_size, out + pos, raw_size > 0 ? raw_size - 1 : 0, hash);
+        if (packed == 0) {
+            memcpy(out + pos, raw, raw_size);
+            packed = raw_size;
+        }
+        b.packed_size = (u32)packed;
+        memcpy(out + sizeof(sf_codec_header) + (size_t)i * sizeof(b), &b, sizeof(b));
+        pos += packed;
+    }
+    free(hash);
+
+    if (out_size) *out_size = pos;
+    return out;
+}
@@ -0,0 +1,38 @@
+#ifndef SF_CODEC_H
+#define SF_CODEC_H
+
+#include <sionflow/base/sf_types.h>
+
+/**
+ * Block compression for cartridge sections ('SFZ1').
+ *
+ * A compressed section is a header, a block table and the packed blocks. Each block is
+ * an independent LZ4-style stream (or stored raw when it does not shrink) with a checksum
+ * of its decoded bytes, so blocks decode in parallel and straight into their destination.
+ */
+
+#define SF_CODEC_MAGIC      0x315A4653u // "SFZ1"
+#define SF_CODEC_BLOCK_SIZE (256u * 1024u)
+
+/**
+ * @brief True if data starts with a compressed section header.
+ */
+bool    sf_codec_check(const void* data, size_t size);
+
+/**
+ * @brief Validates the header and block table and returns the decoded size.
+ */
+bool    sf_codec_raw_size(const void* data, size_t size, size_t* out_raw_size);
+
+/**
+ * @brief Decodes every block into dst (dst_size must equal the decoded size), on up to
+ * max_threads threads (0 = all cores). Fails on corrupt streams or checksum mismatches.
+ */
+bool    sf_codec_decode(const void* data, size_t size, void* dst, size_t dst_size, u32 max_threads);
+
+/**
+ * @brief Compresses src into a malloc'd section payload (block_size 0 = SF_CODEC_BLOCK_SIZE).
+ */
+void*   sf_codec_encode(const void* src, size_t size, u32 block_size, size_t* out_size);
+
+#endif // SF_CODEC_H
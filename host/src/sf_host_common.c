@@ -1,9 +1,11 @@
 #include <sionflow/host/sf_host_desc.h>
+#include <sionflow/host/sf_async_log.h>
 #include <sionflow/engine/sf_engine.h>
 #include <sionflow/base/sf_log.h>
 #include <sionflow/base/sf_platform.h>
 #include "sf_host_internal.h"
 #include "sf_loader.h"
+#include "sf_input_log.h"
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
@@ -35,6 +37,17 @@ void sf_host_init_logger(void) {
     }
     
     sf_log_add_file_sink(log_path, SF_LOG_LEVEL_TRACE);
+
+    // Hot-path records (SF_ALOG_*) go through the async pipeline into a sibling file
+    char async_path[520];
+    size_t len = strlen(log_path);
+    if (len > 4) len -= 4; // Drop ".txt"
+    snprintf(async_path, sizeof(async_path), "%.*s.async.txt", (int)len, log_path);
+    if (sf_alog_start(async_path, SF_LOG_LEVEL_INFO)) atexit(sf_alog_stop);
+}
+
+void sf_host_shutdown_logger(void) {
+    sf_alog_stop();
 }
 
 void sf_host_desc_cleanup(sf_host_desc* desc) {
@@ -61,66 +74,83 @@ static void sf_host_app_bind_resources(sf_host_app* app) {
     if (!app->resources.output) {
         app->resources.output = sf_engine_map_resource(app->engine, "out_Color");
     }
+
+    app->resources.request_frame = sf_engine_map_resource(app->engine, "out_RequestFrame");
+    app->time_driven = sf_engine_is_resource_read(app->engine, "u_Time");
+    app->needs_frame = true;
 }
 
-static void _on_resource_resize(const char* name, sf_tensor* tensor, void* user_data) {
-    sf_host_app* app = (sf_host_app*)user_data;
-    for (u32 i = 0; i < app->desc.pipeline.resource_count; ++i) {
-        if (strcmp(app->desc.pipeline.resources[i].name, name) == 0) {
-            if (app->desc.pipeline.resources[i].flags & SF_RESOURCE_FLAG_SCREEN_SIZE) {
-                int32_t new_shape[3] = { app->inputs.height, app->inputs.width, 4 };
-                if (tensor->info.ndim >= 1) new_shape[2] = tensor->info.shape[tensor->info.ndim-1];
-                sf_engine_resize_resource(app->engine, name, new_shape, tensor->info.ndim);
-            }
-            break;
+static bool _same_asset(const sf_host_asset* a, const sf_host_asset* b) {
+    return a->content_hash != 0 && a->content_hash == b->content_hash &&
+           a->type == b->type && a->font_size == b->font_size &&
+           strcmp(a->resource_name, b->resource_name) == 0 && strcmp(a->path, b->path) == 0;
+}
+
+// prev: descriptor before a hot reload (NULL = load everything)
+static void sf_host_app_load_assets(sf_host_app* app, const sf_host_desc* prev) {
+    for (int i = 0; i < app->desc.asset_count; ++i) {
+        sf_host_asset* asset = &app->desc.assets[i];
+        if (prev && sf_engine_is_resource_kept(app->engine, asset->resource_name)) {
+            // The resource kept its contents; skip it unless the asset itself changed
+            bool unchanged = false;
+            for (int j = 0; j < prev->asset_count && !unchanged; ++j) unchanged = _same_asset(asset, &prev->assets[j]);
+            if (unchanged) continue;
         }
+        if (asset->type == SF_ASSET_IMAGE) {
+            sf_loader_load_image(app->engine, asset->resource_name, asset->path);
+        } else if (asset->type == SF_ASSET_FONT) {
+            sf_loader_load_font(app->engine, asset->resource_name, asset->path, asset->font_size);
+        }
+    }
+}
+
+// Writes the same values into instances [first, end) of a f32 uniform
+static void _write_uniform(sf_host_app* app, const char* name, const f32* values, u32 count, u32 first, u32 end) {
+    for (u32 i = first; i < end; ++i) {
+        sf_tensor view;
+        if (!sf_engine_map_instance(app->engine, name, i, &view)) return;
+        f32* d = (f32*)sf_tensor_data(&view);
+        if (d) memcpy(d, values, count * sizeof(f32));
+    }
+    sf_engine_sync_resource(app->engine, name);
+}
+
+static void _write_frame_inputs(sf_host_app* app, const sf_host_inputs* inputs, u32 first, u32 end) {
+    if (app->resources.time) _write_uniform(app, "u_Time", &inputs->time, 1, first, end);
+
+    if (app->resources.mouse) {
+        f32 mouse[4] = { inputs->mouse_x, inputs->mouse_y, inputs->mouse_lmb ? 1.0f : 0.0f, inputs->mouse_rmb ? 1.0f : 0.0f };
+        _write_uniform(app, "u_Mouse", mouse, 4, first, end);
     }
 }
 
 void sf_host_app_update_inputs(sf_host_app* app, const sf_host_inputs* inputs) {
     if (!app || !app->is_initialized || !inputs) return;
+    u32 batch = sf_engine_get_batch_size(app->engine);
 
-    bool res_changed = (inputs->width != app->inputs.width || inputs->height != app->inputs.height);
+    // A zero size (minimized window) keeps the current resolution
+    bool res_changed = (inputs->width != app->inputs.width || inputs->height != app->inputs.height) &&
+                       inputs->width > 0 && inputs->height > 0;
     app->inputs = *inputs;
 
     if (res_changed) {
-        sf_engine_iterate_resources(app->engine, _on_resource_resize, app);
-        if (app->resources.resolution) {
-            f32* d = sf_tensor_data(app->resources.resolution);
-            if (d) { d[0] = (f32)inputs->width; d[1] = (f32)inputs->height; }
-            sf_engine_sync_resource(app->engine, "u_Resolution");
-        }
-        if (app->resources.res_x) {
-            f32* d = sf_tensor_data(app->resources.res_x);
-            if (d) *d = (f32)inputs->width;
-            sf_engine_sync_resource(app->engine, "u_ResX");
-        }
-        if (app->resources.res_y) {
-            f32* d = sf_tensor_data(app->resources.res_y);
-            if (d) *d = (f32)inputs->height;
-            sf_engine_sync_resource(app->engine, "u_ResY");
-        }
-        if (app->resources.aspect) {
-            f32* d = sf_tensor_data(app->resources.aspect);
-            if (d) *d = (f32)inputs->width / (f32)inputs->height;
-            sf_engine_sync_resource(app->engine, "u_Aspect");
+        if (!sf_engine_resize_screen(app->engine, inputs->width, inputs->height)) {
+            SF_LOG_ERROR("Host: Failed to resize screen resources to %dx%d.", inputs->width, inputs->height);
         }
+        f32 w = (f32)inputs->width, h = (f32)inputs->height, aspect = w / h;
+        f32 resolution[2] = { w, h };
+        if (app->resources.resolution) _write_uniform(app, "u_Resolution", resolution, 2, 0, batch);
+        if (app->resources.res_x) _write_uniform(app, "u_ResX", &w, 1, 0, batch);
+        if (app->resources.res_y) _write_uniform(app, "u_ResY", &h, 1, 0, batch);
+        if (app->resources.aspect) _write_uniform(app, "u_Aspect", &aspect, 1, 0, batch);
     }
 
-    if (app->resources.time) {
-        f32* d = (f32*)sf_tensor_data(app->resources.time);
-        if (d) { *d = inputs->time; sf_engine_sync_resource(app->engine, "u_Time"); }
-    }
+    _write_frame_inputs(app, inputs, 0, batch);
+}
 
-    if (app->resources.mouse) {
-        f32* d = (f32*)sf_tensor_data(app->resources.mouse);
-        if (d) {
-            d[0] = inputs->mouse_x; d[1] = inputs->mouse_y;
-            d[2] = inputs->mouse_lmb ? 1.0f : 0.0f;
-            d[3] = inputs->mouse_rmb ? 1.0f : 0.0f;
-            sf_engine_sync_resource(app->engine, "u_Mouse");
-        }
-    }
+void sf_host_app_update_instance_inputs(sf_host_app* app, uint32_t instance, const sf_host_inputs* inputs) {
+    if (!app || !app->is_initialized || !inputs || instance >= sf_engine_get_batch_size(app->engine)) return;
+    _write_frame_inputs(app, inputs, instance, instance + 1);
 }
 
 int sf_host_app_init(sf_host_app* app, const sf_host_desc* desc, sf_backend backend) {
@@ -128,10 +158,13 @@ int sf_host_app_init(sf_host_app* app, const sf_host_desc* desc, sf_backend back
     memset(app, 0, sizeof(sf_host_app));
     app->desc = *desc; 
 
+    // Limits only reserve address space; cartridges pay for what they touch
     sf_engine_desc engine_desc = { 
-        .arena_size = SF_MB(64), 
-        .heap_size = SF_MB(256),
-        .backend = backend
+        .arena_size = desc->arena_limit ? desc->arena_limit : SF_MB(256), 
+        .heap_size = desc->heap_limit ? desc->heap_limit : SF_MB(1024),
+        .release_on_reset = true,
+        .backend = backend,
+        .batch_size = desc->batch_size
     };
 
     app->engine = sf_engine_create(&engine_desc);
@@ -143,16 +176,7 @@ int sf_host_app_init(sf_host_app* app, const sf_host_desc* desc, sf_backend back
         return -3;
     }
 
-    // Load Assets
-    for (int i = 0; i < desc->asset_count; ++i) {
-        sf_host_asset* asset = &desc->assets[i];
-        if (asset->type == SF_ASSET_IMAGE) {
-            sf_loader_load_image(app->engine, asset->resource_name, asset->path);
-        } else if (asset->type == SF_ASSET_FONT) {
-            sf_loader_load_font(app->engine, asset->resource_name, asset->path, asset->font_size);
-        }
-    }
-
+    sf_host_app_load_assets(app, NULL);
     sf_host_app_bind_resources(app);
     
     // Initial sync
@@ -162,18 +186,96 @@ int sf_host_app_init(sf_host_app* app, const sf_host_desc* desc, sf_backend back
     };
     sf_host_app_update_inputs(app, &initial_inputs);
 
+    if (desc->record_path) {
+        app->recorder = sf_input_log_create(desc->record_path);
+        if (app->recorder) SF_LOG_INFO("Host: Recording inputs to '%s'", desc->record_path);
+    }
+
     app->is_initialized = true;
     return 0;
 }
 
+int sf_host_app_reload(sf_host_app* app, const sf_host_desc* desc) {
+    if (!app || !app->is_initialized || !desc) return -1;
+    sf_host_desc prev = app->desc;
+
+    if (!sf_loader_reload_pipeline(app->engine, &desc->pipeline)) {
+        SF_LOG_ERROR("Host: Failed to reload pipeline");
+        return -3;
+    }
+    app->desc = *desc;
+
+    sf_host_app_load_assets(app, &prev);
+    sf_host_app_bind_resources(app);
+
+    // Force screen-size resources and resolution uniforms to be re-applied
+    sf_host_inputs inputs = app->inputs;
+    app->inputs.width = 0;
+    app->inputs.height = 0;
+    sf_host_app_update_inputs(app, &inputs);
+    return 0;
+}
+
+int sf_host_app_clone(sf_host_app* dst, const sf_host_app* src) {
+    if (!dst || !src || !src->is_initialized) return -1;
+    *dst = *src;
+    dst->recorder = NULL;
+    dst->engine = sf_engine_clone(src->engine);
+    if (!dst->engine) {
+        memset(dst, 0, sizeof(sf_host_app));
+        return -2;
+    }
+    // Re-mapping gives the clone private copies of the inputs the host writes
+    sf_host_app_bind_resources(dst);
+    return 0;
+}
+
+void sf_host_app_rewind(sf_host_app* app) {
+    if (!app || !app->is_initialized) return;
+    sf_engine_rewind(app->engine);
+    sf_host_app_bind_resources(app);
+
+    // Uniforms came back as of the rewind point; re-apply the current inputs over them
+    sf_host_inputs inputs = app->inputs;
+    app->inputs.width = 0;
+    app->inputs.height = 0;
+    sf_host_app_update_inputs(app, &inputs);
+}
+
 sf_engine_error sf_host_app_step(sf_host_app* app) {
     if (!app || !app->engine) return SF_ENGINE_ERR_NONE;
+    if (app->recorder) sf_input_log_write(app->recorder, &app->inputs);
     sf_engine_dispatch(app->engine);
+    app->needs_frame = false;
     return sf_engine_get_error(app->engine);
 }
 
+bool sf_host_app_wants_frame(const sf_host_app* app, const sf_host_inputs* next) {
+    if (!app || !app->engine) return false;
+    if (app->needs_frame || app->time_driven) return true;
+
+    if (app->resources.request_frame) {
+        // Re-map: the front buffer flips every dispatch, so the bound view goes stale
+        sf_tensor* t = sf_engine_map_resource(app->engine, "out_RequestFrame");
+        const void* d = t ? sf_tensor_data(t) : NULL;
+        if (d && t->info.dtype == SF_DTYPE_F32) {
+            if (*(const f32*)d != 0.0f) return true;
+        } else if (d) {
+            // Integer flags: any set byte of the first element requests a frame
+            size_t n = sf_dtype_size(t->info.dtype);
+            for (size_t i = 0; i < n; ++i) if (((const u8*)d)[i]) return true;
+        }
+    }
+
+    const sf_host_inputs* cur = &app->inputs;
+    return next->width != cur->width || next->height != cur->height ||
+           next->mouse_x != cur->mouse_x || next->mouse_y != cur->mouse_y ||
+           next->mouse_lmb != cur->mouse_lmb || next->mouse_rmb != cur->mouse_rmb;
+}
+
 void sf_host_app_cleanup(sf_host_app* app) {
     if (!app) return;
+    if (app->recorder) sf_input_log_close(app->recorder);
     if (app->engine) sf_engine_destroy(app->engine);
     memset(app, 0, sizeof(sf_host_app));
 }
@@ -4,14 +4,315 @@
 #include <sionflow/base/sf_log.h>
 #include "sf_host_internal.h"
 #include "sf_loader.h"
+#include "sf_input_log.h"
+#include <sionflow/engine/sf_thread.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
 
 static void debug_print_resource_callback(const char* name, sf_tensor* t, void* user_data) {
     (void)user_data;
     sf_tensor_print(name, t);
 }
 
+static void memory_entry_callback(const sf_engine_memory_entry* e, void* user_data) {
+    (void)user_data;
+    if (e->is_kernel) {
+        SF_LOG_INFO("  kernel   %-24s registers %10zu B  baked %10zu B", e->name, e->bytes, e->baked_bytes);
+    } else {
+        SF_LOG_INFO("  resource %-24s %10zu B (x%u)", e->name, e->bytes, (unsigned)e->buffer_count);
+    }
+}
+
+// Peak plus 25% headroom, rounded up to whole megabytes
+static size_t recommend_size(size_t peak) {
+    size_t with_headroom = peak + peak / 4;
+    size_t mb = SF_MB(1);
+    return ((with_headroom + mb - 1) / mb) * mb;
+}
+
+static void print_memory_report(sf_engine* engine) {
+    sf_engine_memory_stats st;
+    if (!sf_engine_get_memory_stats(engine, &st)) return;
+
+    SF_LOG_INFO("--- Memory Report ---");
+    SF_LOG_INFO("Arena: used %zu B, peak %zu B, limit %zu B", st.arena_used, st.arena_peak, st.arena_limit);
+    SF_LOG_INFO("Heap:  used %zu B, pooled %zu B, peak %zu B, limit %zu B, %u allocations, fragmentation %.1f%%",
+        st.heap_used, st.heap_cached, st.heap_peak, st.heap_limit, st.allocation_count, st.heap_fragmentation * 100.0f);
+    SF_LOG_INFO("Resources %zu B, registers %zu B, baked %zu B", st.resource_bytes, st.register_bytes, st.baked_bytes);
+    sf_engine_iterate_memory(engine, memory_entry_callback, NULL);
+    SF_LOG_INFO("Recommended: arena_size = %zu MB, heap_size = %zu MB",
+        recommend_size(st.arena_peak) / SF_MB(1), recommend_size(st.heap_peak) / SF_MB(1));
+}
+
+static void counters_callback(const sf_engine_kernel_counters* e, void* user_data) {
+    (void)user_data;
+    double avg_us = e->invocations ? (double)e->time_ns / (double)e->invocations / 1000.0 : 0.0;
+    char label[96];
+    if (e->task_index < 0) snprintf(label, sizeof(label), "%s", e->kernel_id);
+    else snprintf(label, sizeof(label), "  task %d", (int)e->task_index);
+
+    if (!e->counters_valid) {
+        SF_LOG_INFO("  %-24s %8llu runs %10.2f us/run", label, (unsigned long long)e->invocations, avg_us);
+        return;
+    }
+    double ipc = e->cycles ? (double)e->instructions / (double)e->cycles : 0.0;
+    SF_LOG_INFO("  %-24s %8llu runs %10.2f us/run  cycles %12llu  IPC %5.2f  LLC miss %10llu  br miss %10llu",
+        label, (unsigned long long)e->invocations, avg_us, (unsigned long long)e->cycles, ipc,
+        (unsigned long long)e->llc_misses, (unsigned long long)e->branch_misses);
+}
+
+// --- Offline Frame Range Rendering ---
+
+/**
+ * Frames of a frame-independent pipeline go to several engines (clones of the first).
+ * Workers pull frame numbers from a shared counter and park finished outputs in a reorder
+ * window; the calling thread hands them to the sink strictly in frame order. A worker never
+ * runs more than the window ahead of the sink, which bounds the memory held in flight.
+ */
+
+#define SF_RENDER_SLOTS_PER_ENGINE 2u
+#define SF_RENDER_POLL_MS          1u
+
+typedef struct {
+    sf_tensor    view;     // Output description, buffer points at storage
+    sf_buffer    buffer;
+    void*        storage;
+    size_t       capacity;
+    sf_atomic_i32 ready;    // Frame + 1 once filled, 0 while free
+} sf_render_slot;
+
+typedef struct {
+    u32 first_frame;
+    u32 frame_count;
+    f32 dt;
+    sf_host_frame_sink sink;
+    void* user_data;
+
+    sf_render_slot* slots;
+    u32             window;
+    sf_atomic_i32    next_frame;  // Next frame to hand out (relative to first_frame)
+    sf_atomic_i32    emitted;     // Frames passed to the sink
+    sf_atomic_i32    failed;
+    sf_atomic_i32    last_engine; // Worker that rendered the final frame
+} sf_render_job;
+
+typedef struct {
+    sf_render_job* job;
+    sf_host_app*   app;
+    u32            index;
+} sf_render_worker;
+
+static void _sleep_ms(u32 ms) {
+#ifdef _WIN32
+    Sleep(ms);
+#else
+    usleep(ms * 1000u);
+#endif
+}
+
+static bool _render_frame(sf_host_app* app, const sf_render_job* job, u32 f) {
+    sf_host_inputs inputs = {
+        .time = (f32)(job->first_frame + f) * job->dt,
+        .width = app->desc.width,
+        .height = app->desc.height
+    };
+    sf_host_app_update_inputs(app, &inputs);
+
+    sf_engine_error err = sf_host_app_step(app);
+    if (err != SF_ENGINE_ERR_NONE) {
+        SF_LOG_ERROR("Engine failure at frame %u: %s", (unsigned)(job->first_frame + f), sf_engine_error_to_str(err));
+        return false;
+    }
+    return true;
+}
+
+static bool _slot_store(sf_render_slot* slot, const sf_tensor* output) {
+    size_t bytes = sf_tensor_size_bytes(output);
+    if (slot->capacity < bytes) {
+        free(slot->storage);
+        slot->storage = malloc(bytes);
+        slot->capacity = slot->storage ? bytes : 0;
+        if (!slot->storage) return false;
+    }
+    const void* src = sf_tensor_data(output);
+    if (bytes > 0 && src) memcpy(slot->storage, src, bytes);
+
+    memset(&slot->buffer, 0, sizeof(sf_buffer));
+    slot->buffer.data = slot->storage;
+    slot->buffer.size_bytes = bytes;
+    slot->view = *output;
+    slot->view.buffer = &slot->buffer;
+    slot->view.byte_offset = 0;
+    return true;
+}
+
+static void _render_worker(void* user_data) {
+    sf_render_worker* w = (sf_render_worker*)user_data;
+    sf_render_job* job = w->job;
+
+    for (;;) {
+        u32 f = (u32)sf_atomic_i32_fetch_add(&job->next_frame, 1);
+        if (f >= job->frame_count) return;
+
+        // Stay within the reorder window: slot f is free once frame f - window was emitted
+        while (f >= (u32)sf_atomic_load(&job->emitted) + job->window) {
+            if ((u32)sf_atomic_load(&job->failed)) return;
+            _sleep_ms(SF_RENDER_POLL_MS);
+        }
+        if ((u32)sf_atomic_load(&job->failed)) return;
+
+        sf_render_slot* slot = &job->slots[f % job->window];
+        if (!_render_frame(w->app, job, f) || !_slot_store(slot, w->app->resources.output)) {
+            sf_atomic_store(&job->failed, 1);
+            return;
+        }
+        if (f + 1 == job->frame_count) sf_atomic_store(&job->last_engine, w->index);
+        sf_atomic_store(&slot->ready, f + 1);
+    }
+}
+
+static bool _render_serial(sf_host_app* app, sf_render_job* job) {
+    for (u32 f = 0; f < job->frame_count; ++f) {
+        if (!_render_frame(app, job, f)) return false;
+        if (job->sink) job->sink(job->first_frame + f, app->resources.output, job->user_data);
+    }
+    return true;
+}
+
+static u32 _render_engine_count(const sf_host_desc* desc, u32 frame_count) {
+    u32 count = desc->render_engines < 0 ? sf_thread_hw_count() : (u32)desc->render_engines;
+    if (count > frame_count) count = frame_count;
+    return count > 0 ? count : 1;
+}
+
+/**
+ * Renders the job's frames on base and up to desc->render_engines - 1 clones of it.
+ * On success base holds the state of the final frame, as after a serial run.
+ */
+static bool _render_range(sf_host_app* base, const sf_host_desc* desc, sf_render_job* job) {
+    u32 engines = _render_engine_count(desc, job->frame_count);
+    if (engines > 1 && !base->resources.output) {
+        SF_LOG_WARN("Render: Pipeline has no output resource, rendering serially");
+        engines = 1;
+    }
+    if (engines > 1 && !desc->frames_independent && !sf_engine_is_frame_independent(base->engine)) {
+        SF_LOG_INFO("Render: Frames carry state from earlier frames, rendering serially");
+        engines = 1;
+    }
+    if (engines > 1 && !desc->backend_reentrant) {
+        SF_LOG_INFO("Render: Backend is not marked reentrant, rendering serially");
+        engines = 1;
+    }
+    if (engines > 1 && base->recorder) {
+        // Clones don't record, and the log must hold every frame in order
+        SF_LOG_INFO("Render: Recording inputs, rendering serially");
+        engines = 1;
+    }
+    if (engines <= 1) return _render_serial(base, job);
+
+    sf_host_app* clones = calloc(engines, sizeof(sf_host_app));
+    sf_render_worker* workers = calloc(engines, sizeof(sf_render_worker));
+    sf_thread** threads = calloc(engines, sizeof(sf_thread*));
+    job->window = engines * SF_RENDER_SLOTS_PER_ENGINE;
+    job->slots = calloc(job->window, sizeof(sf_render_slot));
+    if (!clones || !workers || !threads || !job->slots) {
+        free(clones); free(workers); free(threads); free(job->slots);
+        job->slots = NULL;
+        SF_LOG_WARN("Render: Out of memory for parallel rendering, rendering serially");
+        return _render_serial(base, job);
+    }
+
+    // Clones are forked on this thread, before any engine starts stepping
+    u32 count = 1;
+    workers[0] = (sf_render_worker){ job, base, 0 };
+    for (u32 i = 1; i < engines; ++i) {
+        if (sf_host_app_clone(&clones[count], base) != 0) {
+            SF_LOG_WARN("Render: Could only create %u of %u engines", (unsigned)count, (unsigned)engines);
+            break;
+        }
+        workers[count] = (sf_render_worker){ job, &clones[count], count };
+        count++;
+    }
+
+    u32 started = 0;
+    for (u32 i = 0; i < count; ++i) {
+        threads[i] = sf_thread_start(_render_worker, &workers[i]);
+        if (threads[i]) started++;
+    }
+    if (started == 0) sf_atomic_store(&job->failed, 1);
+    SF_LOG_INFO("Render: %u frames on %u engines", (unsigned)job->frame_count, (unsigned)started);
+
+    // Reorder: emit frames in sequence as they complete
+    u32 emitted = 0;
+    while (emitted < job->frame_count && !(u32)sf_atomic_load(&job->failed)) {
+        sf_render_slot* slot = &job->slots[emitted % job->window];
+        if ((u32)sf_atomic_load(&slot->ready) != emitted + 1) {
+            _sleep_ms(SF_RENDER_POLL_MS);
+            continue;
+        }
+        if (job->sink) job->sink(job->first_frame + emitted, &slot->view, job->user_data);
+        sf_atomic_store(&slot->ready, 0);
+        sf_atomic_store(&job->emitted, ++emitted);
+    }
+
+    for (u32 i = 0; i < count; ++i) {
+        if (threads[i]) sf_thread_join(threads[i]);
+    }
+    for (u32 i = 1; i < count; ++i) sf_host_app_cleanup(&clones[i]);
+    for (u32 i = 0; i < job->window; ++i) free(job->slots[i].storage);
+    free(job->slots);
+    job->slots = NULL;
+    free(threads);
+    free(workers);
+    free(clones);
+
+    bool ok = emitted == job->frame_count;
+    // Frames are independent, so replaying the last one leaves base exactly at the end state
+    if (ok && (u32)sf_atomic_load(&job->last_engine) != 0) ok = _render_frame(base, job, job->frame_count - 1);
+    return ok;
+}
+
+int sf_host_render_frames(const sf_host_desc* desc, sf_backend backend, u32 first_frame, u32 frame_count, f32 dt,
+                          sf_host_frame_sink sink, void* user_data) {
+    if (!desc) return 1;
+
+    sf_host_app app;
+    if (sf_host_app_init(&app, desc, backend) != 0) {
+        SF_LOG_ERROR("Failed to initialize Host App");
+        return 1;
+    }
+    if (desc->restore_path && !sf_engine_restore(app.engine, desc->restore_path)) {
+        SF_LOG_ERROR("Failed to restore snapshot '%s'", desc->restore_path);
+        sf_host_app_cleanup(&app);
+        return 1;
+    }
+
+    sf_render_job job = {
+        .first_frame = first_frame, .frame_count = frame_count, .dt = dt > 0.0f ? dt : 0.016f,
+        .sink = sink, .user_data = user_data
+    };
+    bool ok = _render_range(&app, desc, &job);
+
+    if (ok && desc->snapshot_path) sf_engine_snapshot(app.engine, desc->snapshot_path, SF_SNAPSHOT_PERSISTENT);
+    sf_host_app_cleanup(&app);
+    return ok ? 0 : 1;
+}
+
+static void headless_frame_sink(u32 frame, const sf_tensor* output, void* user_data) {
+    (void)user_data;
+    if (frame >= 3) return;
+    SF_LOG_INFO("--- Frame %u ---\n", (unsigned)frame);
+    sf_tensor_print("output", output);
+}
+
 int sf_host_run_headless(const sf_host_desc* desc, sf_backend backend, int frames) {
     if (!desc) return 1;
 
@@ -21,13 +322,47 @@ int sf_host_run_headless(const sf_host_desc* desc, sf_backend backend, int frame
         return 1;
     }
 
+    if (desc->restore_path && !sf_engine_restore(app.engine, desc->restore_path)) {
+        SF_LOG_ERROR("Failed to restore snapshot '%s'", desc->restore_path);
+        sf_host_app_cleanup(&app);
+        return 1;
+    }
+
+    sf_input_log* replay = NULL;
+    if (desc->replay_path) {
+        replay = sf_input_log_open(desc->replay_path);
+        if (!replay) {
+            sf_host_app_cleanup(&app);
+            return 1;
+        }
+        // Replay the whole session unless a shorter run was requested
+        u32 recorded = sf_input_log_frame_count(replay);
+        if (frames <= 0 || (u32)frames > recorded) frames = (int)recorded;
+    }
+
+    if (desc->perf_report) sf_engine_enable_profiling(app.engine, desc->perf_per_task);
+
     SF_LOG_INFO("Running for %d frames...\n", frames);
-    for (int f = 0; f < frames; ++f) {
+    struct timespec t_start, t_end;
+    timespec_get(&t_start, TIME_UTC);
+
+    // Parallel offline rendering (synthetic inputs only: a replay is read in order, a recording written in order)
+    bool parallel = !replay && !desc->record_path && frames > 1 && _render_engine_count(desc, (u32)frames) > 1;
+    if (parallel) {
+        sf_render_job job = { .frame_count = (u32)frames, .dt = 0.016f, .sink = headless_frame_sink };
+        if (!_render_range(&app, desc, &job)) SF_LOG_ERROR("Render: Stopped early");
+    }
+
+    for (int f = 0; !parallel && f < frames; ++f) {
         sf_host_inputs inputs = {
             .time = (f32)f * 0.016f,
             .width = desc->width,
             .height = desc->height
         };
+        if (replay) {
+            if (!sf_input_log_read(replay, &inputs)) break;
+            if (desc->replay_fixed_dt > 0.0f) inputs.time = (f32)f * desc->replay_fixed_dt;
+        }
         sf_host_app_update_inputs(&app, &inputs);
 
         sf_engine_error err = sf_host_app_step(&app);
@@ -42,9 +377,23 @@ int sf_host_run_headless(const sf_host_desc* desc, sf_backend backend, int frame
         }
     }
     
+    timespec_get(&t_end, TIME_UTC);
+    if (replay || parallel) {
+        double ms = (double)(t_end.tv_sec - t_start.tv_sec) * 1000.0 + (double)(t_end.tv_nsec - t_start.tv_nsec) / 1.0e6;
+        SF_LOG_INFO("%s: %d frames in %.2f ms (%.3f ms/frame)", replay ? "Replay" : "Render", frames, ms, frames > 0 ? ms / frames : 0.0);
+        if (replay) sf_input_log_close(replay);
+    }
+
     SF_LOG_INFO("--- Final State ---\n");
     sf_engine_iterate_resources(app.engine, debug_print_resource_callback, NULL);
 
+    if (desc->memory_report) print_memory_report(app.engine);
+    if (desc->perf_report) {
+        SF_LOG_INFO("--- Kernel Profile ---");
+        sf_engine_iterate_counters(app.engine, counters_callback, NULL);
+    }
+    if (desc->snapshot_path) sf_engine_snapshot(app.engine, desc->snapshot_path, SF_SNAPSHOT_PERSISTENT);
+
     sf_host_app_cleanup(&app);
     return 0;
 }
\ No newline at end of file
@@ -30,9 +30,13 @@ typedef struct {
         sf_tensor* res_y;
         sf_tensor* aspect;
         sf_tensor* output;
+        sf_tensor* request_frame;
     } resources;
 
     sf_host_inputs inputs;
+    struct sf_input_log* recorder; // Optional: per-frame input recording (desc.record_path)
+    bool time_driven;  // u_Time is read by a kernel: every frame differs
+    bool needs_frame;  // Set on init/reload, cleared by a step
     bool is_initialized;
 } sf_host_app;
 
@@ -42,16 +46,50 @@ typedef struct {
 int sf_host_app_init(sf_host_app* app, const sf_host_desc* desc, sf_backend backend);
 
 /**
- * @brief Updates all system resources (Time, Mouse, Res) in one go.
+ * @brief Updates all system resources (Time, Mouse, Res) in one go, in every batch instance.
  */
 void sf_host_app_update_inputs(sf_host_app* app, const sf_host_inputs* inputs);
 
+/**
+ * @brief Updates Time and Mouse of one batch instance (desc.batch_size > 1).
+ * The screen size is shared by all instances and is ignored here.
+ */
+void sf_host_app_update_instance_inputs(sf_host_app* app, uint32_t instance, const sf_host_inputs* inputs);
+
+/**
+ * @brief Hot-reloads the pipeline and assets from a new descriptor without a cold start.
+ * Unchanged kernels and resources (including persistent state) are kept, and assets are only
+ * loaded again into fresh resources or where the asset entry itself changed.
+ * The caller keeps ownership of desc, which must outlive the app (or the next reload).
+ */
+int sf_host_app_reload(sf_host_app* app, const sf_host_desc* desc);
+
+/**
+ * @brief Forks an initialized app from its current state (sf_engine_clone).
+ * The clone shares programs, bakes and unwritten resources with src and uses src's desc.
+ */
+int sf_host_app_clone(sf_host_app* dst, const sf_host_app* src);
+
+/**
+ * @brief Starts a new session on the loaded pipeline (sf_engine_rewind) without reloading.
+ * Resources return to the engine's rewind point when one was set after setup (assets and
+ * host writes included); the current inputs are applied again.
+ */
+void sf_host_app_rewind(sf_host_app* app);
+
 /**
  * @brief Executes a single frame of the application.
  * Updates state, runs kernels, and checks for errors.
  */
 sf_engine_error sf_host_app_step(sf_host_app* app);
 
+/**
+ * @brief Idle mode check: true if stepping with these inputs can change the output.
+ * That is the first frame after init/reload, a change in size/mouse, a kernel reading u_Time,
+ * or a kernel writing a nonzero value to out_RequestFrame.
+ */
+bool sf_host_app_wants_frame(const sf_host_app* app, const sf_host_inputs* next);
+
 /**
  * @brief Shuts down the application context.
  */
@@ -1,5 +1,7 @@
 #include <sionflow/host/sf_host_sdl.h>
+#include <sionflow/host/sf_async_log.h>
 #include <sionflow/engine/sf_engine.h>
+#include <sionflow/engine/sf_thread.h>
 #include <sionflow/base/sf_platform.h>
 #include <sionflow/base/sf_log.h>
 #include "sf_host_internal.h"
@@ -37,90 +39,427 @@ static void convert_to_pixels(sf_tensor* tensor, void* pixels, int pitch, int te
     }
 }
 
-static bool _sdl_process_events(bool* running, int* win_w, int* win_h, SDL_Window* window, SDL_Renderer* renderer, SDL_Texture** texture, void** frame_buffer) {
+static void _sdl_handle_event(const SDL_Event* event, bool* running, int* win_w, int* win_h) {
+    if (event->type == SDL_QUIT) *running = false;
+    else if (event->type == SDL_WINDOWEVENT && event->window.event == SDL_WINDOWEVENT_RESIZED) {
+        *win_w = event->window.data1;
+        *win_h = event->window.data2;
+    }
+}
+
+/**
+ * Drains pending events. With wait_ms > 0, first blocks until an event arrives or the
+ * timeout expires. Returns true if any event was handled.
+ */
+static bool _sdl_process_events(bool* running, int* win_w, int* win_h, int wait_ms) {
     SDL_Event event;
-    bool resized = false;
+    bool any = false;
+    if (wait_ms > 0 && SDL_WaitEventTimeout(&event, wait_ms)) {
+        _sdl_handle_event(&event, running, win_w, win_h);
+        any = true;
+    }
     while (SDL_PollEvent(&event)) {
-        if (event.type == SDL_QUIT) *running = false;
-        else if (event.type == SDL_WINDOWEVENT && event.window.event == SDL_WINDOWEVENT_RESIZED) {
-            *win_w = event.window.data1;
-            *win_h = event.window.data2;
-            SDL_DestroyTexture(*texture);
-            *texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING, *win_w, *win_h);
-            free(*frame_buffer);
-            *frame_buffer = malloc((size_t)*win_w * *win_h * 4);
-            resized = true;
-        }
+        _sdl_handle_event(&event, running, win_w, win_h);
+        any = true;
     }
-    return resized;
+    return any;
 }
 
-int sf_host_run(const sf_host_desc* desc, sf_backend backend) {
-    if (SDL_Init(SDL_INIT_VIDEO) != 0) return 1;
+/**
+ * Log frames open the synchronous sinks to TRACE for one frame. The global level is
+ * only touched on transitions so ordinary frames pay nothing for it.
+ */
+static void _set_frame_logging(bool* current, bool enabled) {
+    if (*current == enabled) return;
+    sf_log_set_global_level(enabled ? SF_LOG_LEVEL_TRACE : SF_LOG_LEVEL_WARN);
+    *current = enabled;
+}
 
-    u32 flags = SDL_WINDOW_SHOWN;
-    if (desc->resizable) flags |= SDL_WINDOW_RESIZABLE;
-    if (desc->fullscreen) flags |= SDL_WINDOW_FULLSCREEN_DESKTOP;
+/**
+ * Dynamic resolution: screen-size resources run at window size * scale and the
+ * texture is upscaled on present. The scale follows a smoothed step time so the
+ * frame budget holds, and only moves after a settle period to avoid oscillation.
+ */
+#define SF_IDLE_WAIT_MS     100 // Idle wake-up period (keeps logging/screenshots alive)
 
-    SDL_Window* window = SDL_CreateWindow(desc->window_title ? desc->window_title : "SionFlow App",
-        SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, desc->width, desc->height, flags);
-    if (!window) { SDL_Quit(); return 1; }
+#define SF_DRS_SMOOTHING    0.1f
+#define SF_DRS_SETTLE       30
+#define SF_DRS_RAISE_MARGIN 0.75f
+#define SF_DRS_STEP_UP      0.05f
+#define SF_DRS_MAX_STEP_DN  0.15f
+#define SF_DRS_ALIGN        8
 
-    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, desc->vsync ? SDL_RENDERER_PRESENTVSYNC : 0);
-    SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING, desc->width, desc->height);
+typedef struct {
+    f32 budget_ms;
+    f32 min_scale;
+    f32 scale;
+    f32 avg_ms;
+    int settle;
+} sf_drs_state;
 
-    sf_host_app app;
-    if (sf_host_app_init(&app, desc, backend) != 0) { SDL_DestroyWindow(window); SDL_Quit(); return 1; }
+static void _drs_init(sf_drs_state* drs, const sf_host_desc* desc) {
+    memset(drs, 0, sizeof(sf_drs_state));
+    drs->budget_ms = desc->frame_budget_ms;
+    drs->min_scale = (desc->min_render_scale > 0.0f && desc->min_render_scale <= 1.0f) ? desc->min_render_scale : 0.25f;
+    drs->scale = 1.0f;
+    drs->settle = SF_DRS_SETTLE;
+}
 
+static void _drs_update(sf_drs_state* drs, f32 step_ms) {
+    if (drs->budget_ms <= 0.0f) return;
+    drs->avg_ms = (drs->avg_ms == 0.0f) ? step_ms : drs->avg_ms + (step_ms - drs->avg_ms) * SF_DRS_SMOOTHING;
+    if (drs->settle > 0) { drs->settle--; return; }
+
+    f32 scale = drs->scale;
+    if (drs->avg_ms > drs->budget_ms) {
+        // Cost is roughly proportional to pixel count, i.e. scale^2
+        f32 target = scale * SDL_sqrtf(drs->budget_ms / drs->avg_ms);
+        scale = (scale - target > SF_DRS_MAX_STEP_DN) ? scale - SF_DRS_MAX_STEP_DN : target;
+    } else if (drs->avg_ms < drs->budget_ms * SF_DRS_RAISE_MARGIN) {
+        scale += SF_DRS_STEP_UP;
+    }
+    if (scale < drs->min_scale) scale = drs->min_scale;
+    if (scale > 1.0f) scale = 1.0f;
+
+    if (scale != drs->scale) {
+        drs->scale = scale;
+        drs->settle = SF_DRS_SETTLE;
+    }
+}
+
+static int _drs_dim(const sf_drs_state* drs, int win_dim) {
+    if (drs->scale >= 1.0f) return win_dim;
+    int d = (int)((f32)win_dim * drs->scale) / SF_DRS_ALIGN * SF_DRS_ALIGN;
+    return d < SF_DRS_ALIGN ? (win_dim < SF_DRS_ALIGN ? win_dim : SF_DRS_ALIGN) : d;
+}
+
+static void _run_serial(sf_host_app* app, const sf_host_desc* desc, SDL_Renderer* renderer, SDL_Texture** texture) {
     u32* frame_buffer = malloc((size_t)desc->width * desc->height * 4);
     bool running = true;
     u32 start_ticks = SDL_GetTicks();
-    f32 last_log_time = -desc->log_interval - 1.0f; 
+    f32 last_log_time = -desc->log_interval - 1.0f;
+    bool logging = true; // Forces the first frame to settle the global level 
     int win_w = desc->width, win_h = desc->height;
+    int tex_w = desc->width, tex_h = desc->height;
+    double perf_freq = (double)SDL_GetPerformanceFrequency();
+
+    sf_drs_state drs;
+    _drs_init(&drs, desc);
+
+    // Idle mode only pays off when frames depend on inputs alone
+    bool idle = desc->idle_mode && !app->time_driven;
+    if (desc->idle_mode && !idle) SF_LOG_INFO("Host: u_Time is read by the pipeline, idle mode disabled");
 
     while (running) {
         u32 current_ticks = SDL_GetTicks() - start_ticks;
         f32 current_time = current_ticks / 1000.0f;
         
         bool do_log = (desc->log_interval > 0) && (current_time - last_log_time) >= desc->log_interval;
-        sf_log_set_global_level(do_log ? SF_LOG_LEVEL_TRACE : SF_LOG_LEVEL_WARN);
-        if (do_log) { last_log_time = current_time; SF_LOG_INFO("--- Frame Log @ %.2fs ---", current_time); }
+        _set_frame_logging(&logging, do_log);
+        if (do_log) { last_log_time = current_time; SF_ALOG_INFO("--- Frame Log @ %.2fs ---", current_time); }
+
+        bool pending = !idle || sf_host_app_wants_frame(app, &app->inputs);
+        bool had_event = _sdl_process_events(&running, &win_w, &win_h, pending ? 0 : SF_IDLE_WAIT_MS);
 
-        _sdl_process_events(&running, &win_w, &win_h, window, renderer, &texture, (void**)&frame_buffer);
+        // Internal render size (window size unless dynamic resolution is scaling down)
+        int render_w = _drs_dim(&drs, win_w), render_h = _drs_dim(&drs, win_h);
+        if (render_w != tex_w || render_h != tex_h) {
+            SDL_DestroyTexture(*texture);
+            *texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING, render_w, render_h);
+            free(frame_buffer);
+            frame_buffer = malloc((size_t)render_w * render_h * 4);
+            tex_w = render_w; tex_h = render_h;
+            if (do_log) SF_ALOG_INFO("Host: Render size %dx%d (scale %.2f, window %dx%d)", tex_w, tex_h, drs.scale, win_w, win_h);
+        }
         
         int mx, my;
         u32 buttons = SDL_GetMouseState(&mx, &my);
         sf_host_inputs inputs = {
-            .time = current_time, .width = win_w, .height = win_h,
-            .mouse_x = (f32)mx, .mouse_y = (f32)my,
+            .time = current_time, .width = tex_w, .height = tex_h,
+            .mouse_x = (f32)mx * (f32)tex_w / (f32)win_w, .mouse_y = (f32)my * (f32)tex_h / (f32)win_h,
             .mouse_lmb = (buttons & SDL_BUTTON(SDL_BUTTON_LEFT)) != 0,
             .mouse_rmb = (buttons & SDL_BUTTON(SDL_BUTTON_RIGHT)) != 0
         };
-        sf_host_app_update_inputs(&app, &inputs);
+        if (idle && !sf_host_app_wants_frame(app, &inputs)) {
+            // Nothing changed: keep the last frame, re-present only for window events
+            if (had_event) { SDL_RenderCopy(renderer, *texture, NULL, NULL); SDL_RenderPresent(renderer); }
+            continue;
+        }
+        sf_host_app_update_inputs(app, &inputs);
 
-        sf_engine_error err = sf_host_app_step(&app);
+        u64 step_start = SDL_GetPerformanceCounter();
+        sf_engine_error err = sf_host_app_step(app);
+        _drs_update(&drs, (f32)((double)(SDL_GetPerformanceCounter() - step_start) * 1000.0 / perf_freq));
         if (err != SF_ENGINE_ERR_NONE) {
             SF_LOG_ERROR("Engine failure: %s", sf_engine_error_to_str(err));
             running = false;
         }
         
-        if (app.resources.output && frame_buffer) {
-            convert_to_pixels(app.resources.output, frame_buffer, win_w * 4, win_w, win_h);
-            SDL_UpdateTexture(texture, NULL, frame_buffer, win_w * 4);
+        if (app->resources.output && frame_buffer) {
+            convert_to_pixels(app->resources.output, frame_buffer, tex_w * 4, tex_w, tex_h);
+            SDL_UpdateTexture(*texture, NULL, frame_buffer, tex_w * 4);
         }
         
-        SDL_RenderCopy(renderer, texture, NULL, NULL);
+        // Upscales to the window when rendering below native resolution
+        SDL_RenderCopy(renderer, *texture, NULL, NULL);
         SDL_RenderPresent(renderer);
 
         if (do_log && frame_buffer) {
             char shot_path[256]; time_t now = time(NULL); struct tm* t_struct = localtime(&now);
             strftime(shot_path, sizeof(shot_path), "logs/screenshot_%Y-%m-%d_%H-%M-%S.bmp", t_struct);
-            SDL_Surface* ss = SDL_CreateRGBSurfaceFrom(frame_buffer, win_w, win_h, 32, win_w * 4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000);
+            SDL_Surface* ss = SDL_CreateRGBSurfaceFrom(frame_buffer, tex_w, tex_h, 32, tex_w * 4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000);
             if (ss) { SDL_SaveBMP(ss, shot_path); SDL_FreeSurface(ss); }
         }
     }
-    
+
     free(frame_buffer);
+}
+
+// --- Threaded Simulation ---
+
+/**
+ * Threaded mode: the engine steps on its own thread at a fixed rate while the main
+ * thread polls events and presents. Inputs flow through a lock-free SPSC ring,
+ * frames come back through a triple buffer, so neither side ever waits on the other.
+ */
+
+#define SF_SIM_MAILBOX_SIZE 64u // Power of two
+#define SF_SIM_MAX_CATCHUP  5u  // Ticks the sim may fall behind before skipping ahead
+#define SF_FRAME_FRESH      0x4u
+
+typedef struct {
+    int win_w, win_h;
+    f32 mouse_x, mouse_y; // Window coordinates
+    bool mouse_lmb, mouse_rmb;
+} sf_sim_input;
+
+typedef struct {
+    sf_sim_input items[SF_SIM_MAILBOX_SIZE];
+    sf_atomic_i32 head; // Written by the event thread only
+    sf_atomic_i32 tail; // Written by the sim thread only
+} sf_sim_mailbox;
+
+typedef struct {
+    u32*   pixels;
+    size_t capacity;
+    int    w, h;
+} sf_frame_slot;
+
+typedef struct {
+    sf_frame_slot slots[3];
+    sf_atomic_i32  ready; // Latest published slot, | SF_FRAME_FRESH until consumed
+    u32           back;  // Owned by the sim thread
+    u32           front; // Owned by the present thread
+} sf_frame_triple;
+
+typedef struct {
+    sf_host_app*        app;
+    const sf_host_desc* desc;
+    sf_sim_mailbox      mailbox;
+    sf_frame_triple     frames;
+    sf_drs_state        drs;
+    sf_atomic_i32        running;
+    u32                 frame_event; // SDL user event posted after each publish
+} sf_sim_context;
+
+static void _mailbox_push(sf_sim_mailbox* mb, const sf_sim_input* in) {
+    u32 head = (u32)sf_atomic_load(&mb->head);
+    if (head - (u32)sf_atomic_load(&mb->tail) >= SF_SIM_MAILBOX_SIZE) return; // Full: sim is behind, next push carries the state
+    mb->items[head & (SF_SIM_MAILBOX_SIZE - 1)] = *in;
+    sf_atomic_store(&mb->head, head + 1);
+}
+
+static void _mailbox_drain(sf_sim_mailbox* mb, sf_sim_input* latest) {
+    u32 tail = (u32)sf_atomic_load(&mb->tail);
+    u32 head = (u32)sf_atomic_load(&mb->head);
+    if (tail == head) return;
+
+    // Latest state wins, but clicks shorter than a tick are not lost
+    bool lmb = false, rmb = false;
+    for (; tail != head; ++tail) {
+        *latest = mb->items[tail & (SF_SIM_MAILBOX_SIZE - 1)];
+        lmb |= latest->mouse_lmb;
+        rmb |= latest->mouse_rmb;
+    }
+    latest->mouse_lmb = lmb;
+    latest->mouse_rmb = rmb;
+    sf_atomic_store(&mb->tail, tail);
+}
+
+static void _frames_publish(sf_frame_triple* fb) {
+    fb->back = (u32)sf_atomic_i32_exchange(&fb->ready, fb->back | SF_FRAME_FRESH) & 0x3u;
+}
+
+static bool _frames_acquire(sf_frame_triple* fb) {
+    if (!((u32)sf_atomic_load(&fb->ready) & SF_FRAME_FRESH)) return false;
+    fb->front = (u32)sf_atomic_i32_exchange(&fb->ready, fb->front) & 0x3u;
+    return true;
+}
+
+static void _sim_thread(void* user_data) {
+    sf_sim_context* ctx = (sf_sim_context*)user_data;
+    sf_host_app* app = ctx->app;
+    const sf_host_desc* desc = ctx->desc;
+
+    double rate = desc->sim_rate_hz > 0.0f ? (double)desc->sim_rate_hz : 60.0;
+    double freq = (double)SDL_GetPerformanceFrequency();
+    u64 tick_len = (u64)(freq / rate);
+    u64 next_tick = SDL_GetPerformanceCounter();
+    u64 tick = 0;
+
+    sf_sim_input in = { desc->width, desc->height, 0, 0, false, false };
+
+    while ((u32)sf_atomic_load(&ctx->running)) {
+        u64 now = SDL_GetPerformanceCounter();
+        if (now < next_tick) {
+            u32 wait_ms = (u32)((double)(next_tick - now) * 1000.0 / freq);
+            SDL_Delay(wait_ms > 1 ? wait_ms - 1 : 0);
+            continue;
+        }
+        if (now - next_tick > tick_len * SF_SIM_MAX_CATCHUP) next_tick = now;
+
+        _mailbox_drain(&ctx->mailbox, &in);
+        if (in.win_w <= 0 || in.win_h <= 0) {
+            // Minimized: nothing to render at, so hold the sim until the window returns
+            next_tick += tick_len;
+            continue;
+        }
+        int render_w = _drs_dim(&ctx->drs, in.win_w), render_h = _drs_dim(&ctx->drs, in.win_h);
+        sf_host_inputs inputs = {
+            .time = (f32)((double)tick / rate), .width = render_w, .height = render_h,
+            .mouse_x = in.mouse_x * (f32)render_w / (f32)in.win_w, .mouse_y = in.mouse_y * (f32)render_h / (f32)in.win_h,
+            .mouse_lmb = in.mouse_lmb, .mouse_rmb = in.mouse_rmb
+        };
+        sf_host_app_update_inputs(app, &inputs);
+
+        u64 step_start = SDL_GetPerformanceCounter();
+        sf_engine_error err = sf_host_app_step(app);
+        _drs_update(&ctx->drs, (f32)((double)(SDL_GetPerformanceCounter() - step_start) * 1000.0 / freq));
+        if (err != SF_ENGINE_ERR_NONE) {
+            SF_LOG_ERROR("Engine failure: %s", sf_engine_error_to_str(err));
+            sf_atomic_store(&ctx->running, 0);
+            break;
+        }
+
+        sf_frame_slot* slot = &ctx->frames.slots[ctx->frames.back];
+        size_t bytes = (size_t)render_w * render_h * 4;
+        if (slot->capacity < bytes) {
+            free(slot->pixels);
+            slot->pixels = malloc(bytes);
+            slot->capacity = slot->pixels ? bytes : 0;
+        }
+        if (app->resources.output && slot->pixels) {
+            convert_to_pixels(app->resources.output, slot->pixels, render_w * 4, render_w, render_h);
+            slot->w = render_w;
+            slot->h = render_h;
+            _frames_publish(&ctx->frames);
+            if (ctx->frame_event != (u32)-1) {
+                SDL_Event wake = { .type = ctx->frame_event };
+                SDL_PushEvent(&wake);
+            }
+        }
+
+        tick++;
+        next_tick += tick_len;
+    }
+}
+
+static void _run_threaded(sf_host_app* app, const sf_host_desc* desc, SDL_Renderer* renderer, SDL_Texture** texture) {
+    sf_sim_context* ctx = calloc(1, sizeof(sf_sim_context));
+    if (!ctx) return;
+    ctx->app = app;
+    ctx->desc = desc;
+    ctx->frames.back = 0; sf_atomic_store(&ctx->frames.ready, 1); ctx->frames.front = 2;
+    sf_atomic_store(&ctx->running, 1);
+    ctx->frame_event = SDL_RegisterEvents(1);
+    _drs_init(&ctx->drs, desc);
+
+    sf_thread* sim = sf_thread_start(_sim_thread, ctx);
+    if (!sim) {
+        SF_LOG_ERROR("Host: Failed to start simulation thread");
+        free(ctx);
+        return;
+    }
+
+    bool running = true;
+    u32 start_ticks = SDL_GetTicks();
+    f32 last_log_time = -desc->log_interval - 1.0f;
+    bool logging = true; // Forces the first frame to settle the global level
+    int win_w = desc->width, win_h = desc->height;
+    int tex_w = desc->width, tex_h = desc->height;
+    f32 rate = desc->sim_rate_hz > 0.0f ? desc->sim_rate_hz : 60.0f;
+    int idle_wait_ms = (int)(1000.0f / rate) + 1;
+    int wait_ms = 0;
+
+    while (running) {
+        f32 current_time = (SDL_GetTicks() - start_ticks) / 1000.0f;
+        bool do_log = (desc->log_interval > 0) && (current_time - last_log_time) >= desc->log_interval;
+        _set_frame_logging(&logging, do_log);
+        if (do_log) { last_log_time = current_time; SF_ALOG_INFO("--- Frame Log @ %.2fs ---", current_time); }
+
+        _sdl_process_events(&running, &win_w, &win_h, wait_ms);
+        if (!(u32)sf_atomic_load(&ctx->running)) running = false;
+
+        int mx, my;
+        u32 buttons = SDL_GetMouseState(&mx, &my);
+        sf_sim_input in = {
+            win_w, win_h, (f32)mx, (f32)my,
+            (buttons & SDL_BUTTON(SDL_BUTTON_LEFT)) != 0, (buttons & SDL_BUTTON(SDL_BUTTON_RIGHT)) != 0
+        };
+        _mailbox_push(&ctx->mailbox, &in);
+
+        if (!_frames_acquire(&ctx->frames)) {
+            // Nothing new: block until the sim posts a frame or input arrives, vsync or not
+            wait_ms = idle_wait_ms;
+            continue;
+        }
+        wait_ms = 0;
+
+        sf_frame_slot* slot = &ctx->frames.slots[ctx->frames.front];
+        if (slot->w != tex_w || slot->h != tex_h) {
+            SDL_DestroyTexture(*texture);
+            *texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING, slot->w, slot->h);
+            tex_w = slot->w; tex_h = slot->h;
+        }
+        SDL_UpdateTexture(*texture, NULL, slot->pixels, tex_w * 4);
+        SDL_RenderCopy(renderer, *texture, NULL, NULL);
+        SDL_RenderPresent(renderer);
+
+        if (do_log) {
+            char shot_path[256]; time_t now = time(NULL); struct tm* t_struct = localtime(&now);
+            strftime(shot_path, sizeof(shot_path), "logs/screenshot_%Y-%m-%d_%H-%M-%S.bmp", t_struct);
+            SDL_Surface* ss = SDL_CreateRGBSurfaceFrom(slot->pixels, tex_w, tex_h, 32, tex_w * 4, 0x000000FF, 0x0000FF00, 0x00FF0000, 0xFF000000);
+            if (ss) { SDL_SaveBMP(ss, shot_path); SDL_FreeSurface(ss); }
+        }
+    }
+
+    sf_atomic_store(&ctx->running, 0);
+    sf_thread_join(sim);
+    for (int i = 0; i < 3; ++i) free(ctx->frames.slots[i].pixels);
+    free(ctx);
+}
+
+int sf_host_run(const sf_host_desc* desc, sf_backend backend) {
+    if (SDL_Init(SDL_INIT_VIDEO) != 0) return 1;
+
+    u32 flags = SDL_WINDOW_SHOWN;
+    if (desc->resizable) flags |= SDL_WINDOW_RESIZABLE;
+    if (desc->fullscreen) flags |= SDL_WINDOW_FULLSCREEN_DESKTOP;
+
+    SDL_Window* window = SDL_CreateWindow(desc->window_title ? desc->window_title : "SionFlow App",
+        SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, desc->width, desc->height, flags);
+    if (!window) { SDL_Quit(); return 1; }
+
+    SDL_Renderer* renderer = SDL_CreateRenderer(window, -1, desc->vsync ? SDL_RENDERER_PRESENTVSYNC : 0);
+    SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STREAMING, desc->width, desc->height);
+
+    sf_host_app app;
+    if (sf_host_app_init(&app, desc, backend) != 0) { SDL_DestroyWindow(window); SDL_Quit(); return 1; }
+
+    if (desc->frame_budget_ms > 0.0f) SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear");
+    if (desc->threaded_sim) _run_threaded(&app, desc, renderer, &texture);
+    else _run_serial(&app, desc, renderer, &texture);
+
     sf_host_app_cleanup(&app);
     SDL_DestroyTexture(texture);
     SDL_DestroyRenderer(renderer);
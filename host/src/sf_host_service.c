@@ -0,0 +1,632 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // memfd_create
+#endif
+
+#include <sionflow/host/sf_host_service.h>
+#include <sionflow/engine/sf_engine.h>
+#include <sionflow/engine/sf_thread.h>
+#include <sionflow/base/sf_log.h>
+#include "sf_host_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0 // SIGPIPE is ignored instead
+#endif
+
+#define SF_SERVICE_POLL_MS      200  // Shutdown latency of the dispatcher
+#define SF_SERVICE_MAX_CONNS    256u // Open client connections
+#define SF_SERVICE_MAX_OUTPUTS  64u
+#define SF_SERVICE_MAX_INPUTS   64u
+#define SF_SERVICE_PATH_LEN     512u
+
+/** Warm engines for one cartridge. Apps are checked out by one request at a time. */
+typedef struct {
+    char            path[SF_SERVICE_PATH_LEN]; // Empty = default cartridge
+    sf_host_desc    desc;      // Must outlive the apps (they reference its pipeline)
+    bool            owns_desc;
+    sf_host_app*    apps;
+    bool*           busy;
+    u32             count;
+    pthread_mutex_t lock;
+    pthread_cond_t  available;
+} sf_service_pool;
+
+typedef struct {
+    sf_backend        backend;
+    bool              backend_reentrant;
+    pthread_mutex_t   backend_lock; // Serializes backend use when it is not reentrant
+    sf_service_pool** pools;
+    u32               pool_count;
+    u32               max_pools;
+    u32               pool_size;
+    pthread_mutex_t   pools_lock;
+    int               listen_fd;
+
+    // Connections with a pending request, handed from the dispatcher to the workers
+    pthread_mutex_t   conn_lock;
+    pthread_cond_t    conn_ready;
+    int               ready[SF_SERVICE_MAX_CONNS];
+    u32               ready_head, ready_count;
+    bool              stopping;
+    int               wake_pipe[2]; // Workers return served connections to the dispatcher
+} sf_service_ctx;
+
+static volatile sig_atomic_t g_service_stop = 0;
+
+static void _on_signal(int sig) {
+    (void)sig;
+    g_service_stop = 1;
+}
+
+// --- Engine Pools ---
+
+static void _pool_destroy(sf_service_pool* pool) {
+    for (u32 i = 0; i < pool->count; ++i) sf_host_app_cleanup(&pool->apps[i]);
+    free(pool->apps);
+    free(pool->busy);
+    if (pool->owns_desc) sf_host_desc_cleanup(&pool->desc);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->available);
+    memset(pool, 0, sizeof(sf_service_pool));
+}
+
+static bool _pool_init(sf_service_pool* pool, const char* path, const sf_host_desc* desc, u32 size, sf_backend backend) {
+    memset(pool, 0, sizeof(sf_service_pool));
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->available, NULL);
+    snprintf(pool->path, sizeof(pool->path), "%s", path);
+
+    if (desc) {
+        pool->desc = *desc;
+    } else {
+        if (sf_app_load_config(path, &pool->desc) != 0) {
+            SF_LOG_ERROR("Service: Failed to load cartridge '%s'", path);
+            _pool_destroy(pool);
+            return false;
+        }
+        pool->owns_desc = true;
+    }
+
+    pool->apps = calloc(size, sizeof(sf_host_app));
+    pool->busy = calloc(size, sizeof(bool));
+    if (!pool->apps || !pool->busy) { _pool_destroy(pool); return false; }
+
+    // One cold start per cartridge; the rest of the pool forks from it copy-on-write
+    for (u32 i = 0; i < size; ++i) {
+        int rc = (i == 0) ? sf_host_app_init(&pool->apps[0], &pool->desc, backend) : sf_host_app_clone(&pool->apps[i], &pool->apps[0]);
+        if (rc != 0) {
+            SF_LOG_ERROR("Service: Failed to initialize engine %u for '%s'", i, path[0] ? path : "<default>");
+            _pool_destroy(pool);
+            return false;
+        }
+        // Requests rewind to the loaded state (assets included); clones share the capture
+        if (i == 0) sf_engine_set_rewind_point(pool->apps[0].engine);
+        pool->count++;
+    }
+    SF_LOG_INFO("Service: Pooled %u engines for '%s'", size, path[0] ? path : "<default>");
+    return true;
+}
+
+static void _backend_lock(sf_service_ctx* ctx) {
+    if (!ctx->backend_reentrant) pthread_mutex_lock(&ctx->backend_lock);
+}
+
+static void _backend_unlock(sf_service_ctx* ctx) {
+    if (!ctx->backend_reentrant) pthread_mutex_unlock(&ctx->backend_lock);
+}
+
+// Caller holds pools_lock
+static sf_service_pool* _lookup_pool(sf_service_ctx* ctx, const char* path) {
+    for (u32 i = 0; i < ctx->pool_count; ++i) {
+        if (strcmp(ctx->pools[i]->path, path) == 0) return ctx->pools[i];
+    }
+    return NULL;
+}
+
+static sf_service_pool* _find_pool(sf_service_ctx* ctx, const char* path) {
+    pthread_mutex_lock(&ctx->pools_lock);
+    sf_service_pool* found = _lookup_pool(ctx, path);
+    bool full = ctx->pool_count >= ctx->max_pools;
+    pthread_mutex_unlock(&ctx->pools_lock);
+    if (found) return found;
+    if (full) {
+        SF_LOG_ERROR("Service: Cartridge limit (%u) reached, rejecting '%s'", ctx->max_pools, path);
+        return NULL;
+    }
+
+    // Cold path: the first request for a cartridge pays for its pool, outside the lock
+    // so requests for warm cartridges keep flowing
+    sf_service_pool* pool = malloc(sizeof(sf_service_pool));
+    if (!pool) return NULL;
+    _backend_lock(ctx);
+    bool loaded = _pool_init(pool, path, NULL, ctx->pool_size, ctx->backend);
+    _backend_unlock(ctx);
+    if (!loaded) {
+        free(pool);
+        return NULL;
+    }
+
+    pthread_mutex_lock(&ctx->pools_lock);
+    found = _lookup_pool(ctx, path); // Another request may have loaded it meanwhile
+    if (!found && ctx->pool_count < ctx->max_pools) {
+        ctx->pools[ctx->pool_count++] = pool;
+        found = pool;
+        pool = NULL;
+    }
+    pthread_mutex_unlock(&ctx->pools_lock);
+    if (pool) {
+        _pool_destroy(pool);
+        free(pool);
+        if (!found) SF_LOG_ERROR("Service: Cartridge limit (%u) reached, rejecting '%s'", ctx->max_pools, path);
+    }
+    return found;
+}
+
+static u32 _pool_acquire(sf_service_pool* pool) {
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        for (u32 i = 0; i < pool->count; ++i) {
+            if (!pool->busy[i]) {
+                pool->busy[i] = true;
+                pthread_mutex_unlock(&pool->lock);
+                return i;
+            }
+        }
+        pthread_cond_wait(&pool->available, &pool->lock);
+    }
+}
+
+static void _pool_release(sf_service_pool* pool, u32 index) {
+    pthread_mutex_lock(&pool->lock);
+    pool->busy[index] = false;
+    pthread_cond_signal(&pool->available);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+// --- Messages ---
+
+static size_t _align8(size_t v) { return (v + 7) & ~(size_t)7; }
+static size_t _align_shm(size_t v) { return (v + SF_SERVICE_SHM_ALIGN - 1) & ~(size_t)(SF_SERVICE_SHM_ALIGN - 1); }
+
+typedef struct {
+    sf_service_request      header;
+    char                    cartridge[SF_SERVICE_PATH_LEN];
+    const sf_service_input* inputs[SF_SERVICE_MAX_INPUTS];
+    const sf_service_name*  outputs;
+} sf_service_parsed;
+
+static bool _parse_request(const u8* msg, size_t size, sf_service_parsed* out) {
+    if (size < sizeof(sf_service_request)) return false;
+    memcpy(&out->header, msg, sizeof(sf_service_request));
+    const sf_service_request* req = &out->header;
+    if (req->magic != SF_SERVICE_REQUEST_MAGIC || req->version != SF_SERVICE_VERSION) return false;
+    if (req->cartridge_len >= SF_SERVICE_PATH_LEN || req->input_count > SF_SERVICE_MAX_INPUTS || req->output_count > SF_SERVICE_MAX_OUTPUTS) return false;
+
+    size_t pos = sizeof(sf_service_request);
+    if (size - pos < req->cartridge_len) return false;
+    memcpy(out->cartridge, msg + pos, req->cartridge_len);
+    out->cartridge[req->cartridge_len] = '\0';
+    pos = _align8(pos + req->cartridge_len);
+
+    for (u32 i = 0; i < req->input_count; ++i) {
+        if (pos > size || size - pos < sizeof(sf_service_input)) return false;
+        const sf_service_input* in = (const sf_service_input*)(msg + pos);
+        pos += sizeof(sf_service_input);
+        if (size - pos < in->bytes) return false;
+        out->inputs[i] = in;
+        pos = _align8(pos + in->bytes);
+    }
+
+    if (pos > size || (size - pos) / sizeof(sf_service_name) < req->output_count) return false;
+    out->outputs = (const sf_service_name*)(msg + pos);
+    return true;
+}
+
+static void _apply_named_inputs(sf_host_app* app, const sf_service_parsed* req) {
+    for (u32 i = 0; i < req->header.input_count; ++i) {
+        const sf_service_input* in = req->inputs[i];
+        char name[SF_SERVICE_NAME_LEN];
+        memcpy(name, in->name, SF_SERVICE_NAME_LEN);
+        name[SF_SERVICE_NAME_LEN - 1] = '\0';
+
+        sf_tensor* t = sf_engine_map_resource(app->engine, name);
+        void* dst = t ? sf_tensor_data(t) : NULL;
+        if (!dst) {
+            SF_LOG_ERROR("Service: Unknown input resource '%s'", name);
+            continue;
+        }
+        size_t cap = sf_tensor_size_bytes(t);
+        memcpy(dst, (const u8*)(in + 1), in->bytes < cap ? in->bytes : cap);
+        sf_engine_broadcast_instance(app->engine, name);
+        sf_engine_sync_resource(app->engine, name);
+    }
+}
+
+static sf_service_status _run_frames(sf_host_app* app, const sf_service_parsed* req, u32* out_frames) {
+    const sf_service_request* h = &req->header;
+    sf_host_inputs inputs = app->inputs;
+    // Pooled engines carry the last request's state; a request only sees it when it asks to
+    if (!(h->flags & SF_SERVICE_FLAG_CONTINUE)) {
+        sf_host_app_rewind(app);
+        inputs.width = app->desc.width;
+        inputs.height = app->desc.height;
+    }
+
+    if (h->width > 0 && h->height > 0) { inputs.width = h->width; inputs.height = h->height; }
+    inputs.mouse_x = h->mouse[0];
+    inputs.mouse_y = h->mouse[1];
+    inputs.mouse_lmb = h->mouse[2] != 0.0f;
+    inputs.mouse_rmb = h->mouse[3] != 0.0f;
+    inputs.time = h->time;
+
+    // Size first (named inputs may target screen-size resources), then overrides
+    sf_host_app_update_inputs(app, &inputs);
+    _apply_named_inputs(app, req);
+
+    *out_frames = 0;
+    for (u32 f = 0; f < h->frames; ++f) {
+        if (f > 0) {
+            inputs.time = h->time + (f32)f * h->dt;
+            sf_host_app_update_inputs(app, &inputs);
+        }
+        sf_engine_error err = sf_host_app_step(app);
+        if (err != SF_ENGINE_ERR_NONE) {
+            SF_LOG_ERROR("Service: Engine failure: %s", sf_engine_error_to_str(err));
+            return SF_SERVICE_ERR_ENGINE;
+        }
+        (*out_frames)++;
+    }
+    return SF_SERVICE_OK;
+}
+
+static int _shm_create(size_t bytes) {
+#ifdef __linux__
+    int fd = memfd_create("sf_service_reply", MFD_CLOEXEC);
+#else
+    static sf_atomic_i32 counter = 0;
+    char name[64];
+    snprintf(name, sizeof(name), "/sf_service_%d_%u", (int)getpid(), (u32)sf_atomic_i32_fetch_add(&counter, 1));
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd >= 0) shm_unlink(name);
+#endif
+    if (fd < 0) return -1;
+    if (ftruncate(fd, (off_t)bytes) != 0) { close(fd); return -1; }
+    return fd;
+}
+
+/**
+ * Lays out the requested outputs in one shared-memory block and copies them in.
+ * Returns the fd (or -1 when nothing was requested / on failure, see status).
+ */
+static int _collect_outputs(sf_host_app* app, const sf_service_parsed* req, sf_service_output* outs, u64* out_bytes, sf_service_status* status) {
+    sf_tensor* tensors[SF_SERVICE_MAX_OUTPUTS];
+    size_t total = 0;
+
+    for (u32 i = 0; i < req->header.output_count; ++i) {
+        sf_service_output* o = &outs[i];
+        memset(o, 0, sizeof(sf_service_output));
+        memcpy(o->name, req->outputs[i].name, SF_SERVICE_NAME_LEN);
+        o->name[SF_SERVICE_NAME_LEN - 1] = '\0';
+
+        // Mapped after stepping: resources may have swapped front buffers
+        sf_tensor* t = sf_engine_map_resource(app->engine, o->name);
+        tensors[i] = (t && sf_tensor_data(t)) ? t : NULL;
+        if (!tensors[i]) continue;
+
+        o->dtype = (u32)t->info.dtype;
+        o->ndim = t->info.ndim;
+        memcpy(o->shape, t->info.shape, sizeof(o->shape));
+        o->offset = total;
+        o->bytes = sf_tensor_size_bytes(t);
+        total = _align_shm(total + (size_t)o->bytes);
+    }
+
+    *out_bytes = 0;
+    if (total == 0) return -1;
+
+    int fd = _shm_create(total);
+    u8* map = (fd >= 0) ? mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    if (map == MAP_FAILED) {
+        if (fd >= 0) close(fd);
+        *status = SF_SERVICE_ERR_SHM;
+        return -1;
+    }
+    for (u32 i = 0; i < req->header.output_count; ++i) {
+        if (tensors[i]) memcpy(map + outs[i].offset, sf_tensor_data(tensors[i]), (size_t)outs[i].bytes);
+    }
+    munmap(map, total);
+    *out_bytes = total;
+    return fd;
+}
+
+static bool _send_reply(int conn, const void* data, size_t size, int fd) {
+    struct iovec iov = { (void*)data, size };
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+
+    union { char buf[CMSG_SPACE(sizeof(int))]; struct cmsghdr align; } control;
+    if (fd >= 0) {
+        memset(&control, 0, sizeof(control));
+        msg.msg_control = control.buf;
+        msg.msg_controllen = sizeof(control.buf);
+        struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    }
+    return sendmsg(conn, &msg, MSG_NOSIGNAL) == (ssize_t)size;
+}
+
+static bool _handle_request(sf_service_ctx* ctx, int conn, const u8* msg, size_t size, u8* reply_buf) {
+    sf_service_reply* reply = (sf_service_reply*)reply_buf;
+    sf_service_output* outs = (sf_service_output*)(reply + 1);
+    memset(reply, 0, sizeof(sf_service_reply));
+    reply->magic = SF_SERVICE_REPLY_MAGIC;
+
+    sf_service_parsed req;
+    if (!_parse_request(msg, size, &req)) {
+        reply->status = SF_SERVICE_ERR_BAD_REQUEST;
+        return _send_reply(conn, reply, sizeof(sf_service_reply), -1);
+    }
+
+    sf_service_pool* pool = _find_pool(ctx, req.cartridge);
+    if (!pool) {
+        reply->status = SF_SERVICE_ERR_CARTRIDGE;
+        return _send_reply(conn, reply, sizeof(sf_service_reply), -1);
+    }
+
+    u32 slot = _pool_acquire(pool);
+    sf_host_app* app = &pool->apps[slot];
+    _backend_lock(ctx);
+    sf_service_status status = _run_frames(app, &req, &reply->frames);
+    _backend_unlock(ctx);
+    int fd = -1;
+    if (status == SF_SERVICE_OK) {
+        reply->output_count = req.header.output_count;
+        fd = _collect_outputs(app, &req, outs, &reply->shm_bytes, &status);
+    }
+    _pool_release(pool, slot);
+
+    reply->status = (u32)status;
+    if (status != SF_SERVICE_OK) reply->output_count = 0;
+    size_t reply_size = sizeof(sf_service_reply) + reply->output_count * sizeof(sf_service_output);
+    bool sent = _send_reply(conn, reply, reply_size, fd);
+    if (fd >= 0) close(fd);
+    return sent;
+}
+
+// --- Connections ---
+
+/**
+ * The dispatcher (the service's main thread) polls the listening socket and every idle
+ * connection. A connection with a pending request is queued for the workers; the worker
+ * serves that one request and hands the connection back through wake_pipe. Idle
+ * keep-alive clients therefore hold no worker.
+ */
+
+static bool _queue_ready(sf_service_ctx* ctx, int conn) {
+    pthread_mutex_lock(&ctx->conn_lock);
+    bool queued = ctx->ready_count < SF_SERVICE_MAX_CONNS;
+    if (queued) {
+        ctx->ready[(ctx->ready_head + ctx->ready_count++) % SF_SERVICE_MAX_CONNS] = conn;
+        pthread_cond_signal(&ctx->conn_ready);
+    }
+    pthread_mutex_unlock(&ctx->conn_lock);
+    return queued;
+}
+
+static int _take_ready(sf_service_ctx* ctx) {
+    pthread_mutex_lock(&ctx->conn_lock);
+    while (ctx->ready_count == 0 && !ctx->stopping) pthread_cond_wait(&ctx->conn_ready, &ctx->conn_lock);
+    int conn = -1;
+    if (ctx->ready_count > 0) {
+        conn = ctx->ready[ctx->ready_head];
+        ctx->ready_head = (ctx->ready_head + 1) % SF_SERVICE_MAX_CONNS;
+        ctx->ready_count--;
+    }
+    pthread_mutex_unlock(&ctx->conn_lock);
+    return conn;
+}
+
+static void _worker(void* user_data) {
+    sf_service_ctx* ctx = (sf_service_ctx*)user_data;
+    u8* msg = malloc(SF_SERVICE_MAX_MESSAGE);
+    u8* reply_buf = malloc(sizeof(sf_service_reply) + SF_SERVICE_MAX_OUTPUTS * sizeof(sf_service_output));
+
+    for (;;) {
+        int conn = _take_ready(ctx);
+        if (conn < 0) break; // Stopping
+
+        bool keep = false;
+        if (msg && reply_buf) {
+            ssize_t n = recv(conn, msg, SF_SERVICE_MAX_MESSAGE, MSG_DONTWAIT);
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) keep = true; // Spurious wakeup
+            else if (n > 0) keep = _handle_request(ctx, conn, msg, (size_t)n, reply_buf);
+            // n == 0: closed by the client
+        }
+        if (!keep || write(ctx->wake_pipe[1], &conn, sizeof(int)) != (ssize_t)sizeof(int)) close(conn);
+    }
+    free(msg);
+    free(reply_buf);
+}
+
+static void _dispatch(sf_service_ctx* ctx) {
+    int idle[SF_SERVICE_MAX_CONNS];
+    u32 idle_count = 0;
+    struct pollfd fds[SF_SERVICE_MAX_CONNS + 2];
+
+    while (!g_service_stop) {
+        fds[0] = (struct pollfd){ ctx->listen_fd, POLLIN, 0 };
+        fds[1] = (struct pollfd){ ctx->wake_pipe[0], POLLIN, 0 };
+        for (u32 i = 0; i < idle_count; ++i) fds[i + 2] = (struct pollfd){ idle[i], POLLIN, 0 };
+        int ready = poll(fds, idle_count + 2, SF_SERVICE_POLL_MS);
+        if (ready < 0 && errno != EINTR) break;
+        if (ready <= 0) continue;
+
+        // Queue connections with a request (or a hangup, which the worker closes)
+        u32 kept = 0;
+        for (u32 i = 0; i < idle_count; ++i) {
+            if ((fds[i + 2].revents & (POLLIN | POLLHUP | POLLERR)) && _queue_ready(ctx, idle[i])) continue;
+            idle[kept++] = idle[i];
+        }
+        idle_count = kept;
+
+        if (fds[1].revents & POLLIN) {
+            int back[16];
+            ssize_t n = read(ctx->wake_pipe[0], back, sizeof(back));
+            for (ssize_t i = 0; i < n / (ssize_t)sizeof(int); ++i) {
+                if (idle_count < SF_SERVICE_MAX_CONNS) idle[idle_count++] = back[i];
+                else close(back[i]);
+            }
+        }
+
+        if (fds[0].revents & POLLIN) {
+            for (int conn; (conn = accept(ctx->listen_fd, NULL, NULL)) >= 0;) {
+                if (idle_count == SF_SERVICE_MAX_CONNS) {
+                    SF_LOG_WARN("Service: Connection limit (%u) reached", SF_SERVICE_MAX_CONNS);
+                    close(conn);
+                    continue;
+                }
+                fcntl(conn, F_SETFL, fcntl(conn, F_GETFL) & ~O_NONBLOCK);
+                idle[idle_count++] = conn;
+            }
+        }
+    }
+
+    pthread_mutex_lock(&ctx->conn_lock);
+    ctx->stopping = true;
+    pthread_cond_broadcast(&ctx->conn_ready);
+    pthread_mutex_unlock(&ctx->conn_lock);
+    for (u32 i = 0; i < idle_count; ++i) close(idle[i]);
+}
+
+static int _listen(const char* path) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (strlen(path) >= sizeof(addr.sun_path)) {
+        SF_LOG_ERROR("Service: Socket path too long: '%s'", path);
+        return -1;
+    }
+    strcpy(addr.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    if (fd < 0) return -1;
+    unlink(path); // Stale socket from a previous run
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || listen(fd, 64) != 0) {
+        SF_LOG_ERROR("Service: Cannot listen on '%s': %s", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    return fd;
+}
+
+int sf_host_run_service(const sf_host_desc* desc, const sf_host_service_desc* service, sf_backend backend) {
+    if (!desc || !service || !service->socket_path) return 1;
+
+    sf_service_ctx ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.backend = backend;
+    ctx.backend_reentrant = desc->backend_reentrant;
+    ctx.pool_size = service->pool_size ? service->pool_size : 2;
+    ctx.max_pools = service->max_cartridges ? service->max_cartridges : 8;
+    ctx.pools = calloc(ctx.max_pools, sizeof(sf_service_pool*));
+    if (ctx.pools) ctx.pools[0] = malloc(sizeof(sf_service_pool));
+    if (!ctx.pools || !ctx.pools[0] || pipe(ctx.wake_pipe) != 0) {
+        if (ctx.pools) free(ctx.pools[0]);
+        free(ctx.pools);
+        return 1;
+    }
+    pthread_mutex_init(&ctx.pools_lock, NULL);
+    pthread_mutex_init(&ctx.backend_lock, NULL);
+    pthread_mutex_init(&ctx.conn_lock, NULL);
+    pthread_cond_init(&ctx.conn_ready, NULL);
+    if (!ctx.backend_reentrant) SF_LOG_INFO("Service: Backend is not marked reentrant, engines step one at a time");
+
+    int rc = 1;
+    u32 worker_count = service->worker_count ? service->worker_count : ctx.pool_size;
+    sf_thread** workers = calloc(worker_count, sizeof(sf_thread*));
+
+    if (workers && _pool_init(ctx.pools[0], "", desc, ctx.pool_size, backend)) {
+        ctx.pool_count = 1;
+        ctx.listen_fd = _listen(service->socket_path);
+    } else {
+        ctx.listen_fd = -1;
+    }
+
+    if (ctx.listen_fd >= 0) {
+        g_service_stop = 0;
+        struct sigaction sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = _on_signal;
+        sigaction(SIGINT, &sa, NULL);
+        sigaction(SIGTERM, &sa, NULL);
+        signal(SIGPIPE, SIG_IGN);
+
+        u32 started = 0;
+        for (u32 i = 0; i < worker_count; ++i) {
+            workers[i] = sf_thread_start(_worker, &ctx);
+            if (workers[i]) started++;
+        }
+        SF_LOG_INFO("Service: Listening on '%s' (%u workers, %u engines per cartridge)", service->socket_path, started, ctx.pool_size);
+
+        if (started) _dispatch(&ctx);
+        else ctx.stopping = true;
+
+        for (u32 i = 0; i < worker_count; ++i) {
+            if (workers[i]) sf_thread_join(workers[i]);
+        }
+        // Connections still queued or handed back by the last requests
+        for (u32 i = 0; i < ctx.ready_count; ++i) close(ctx.ready[(ctx.ready_head + i) % SF_SERVICE_MAX_CONNS]);
+        fcntl(ctx.wake_pipe[0], F_SETFL, fcntl(ctx.wake_pipe[0], F_GETFL) | O_NONBLOCK);
+        for (int conn; read(ctx.wake_pipe[0], &conn, sizeof(int)) == (ssize_t)sizeof(int);) close(conn);
+
+        close(ctx.listen_fd);
+        unlink(service->socket_path);
+        SF_LOG_INFO("Service: Stopped");
+        rc = started ? 0 : 1;
+    }
+
+    for (u32 i = 0; i < ctx.pool_count; ++i) {
+        _pool_destroy(ctx.pools[i]);
+        free(ctx.pools[i]);
+    }
+    if (ctx.pool_count == 0) free(ctx.pools[0]);
+    close(ctx.wake_pipe[0]);
+    close(ctx.wake_pipe[1]);
+    pthread_cond_destroy(&ctx.conn_ready);
+    pthread_mutex_destroy(&ctx.conn_lock);
+    pthread_mutex_destroy(&ctx.backend_lock);
+    pthread_mutex_destroy(&ctx.pools_lock);
+    free(ctx.pools);
+    free(workers);
+    return rc;
+}
+
+#else // _WIN32
+
+int sf_host_run_service(const sf_host_desc* desc, const sf_host_service_desc* service, sf_backend backend) {
+    (void)desc; (void)service; (void)backend;
+    SF_LOG_ERROR("Service: Unix domain socket service is not available on this platform");
+    return 1;
+}
+
+#endif
@@ -0,0 +1,122 @@
+#include "sf_input_log.h"
+#include <sionflow/base/sf_log.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SF_INPUT_LOG_MAGIC   0x52494653u // "SFIR"
+#define SF_INPUT_LOG_VERSION 1u
+
+#define SF_INPUT_BUTTON_LMB  0x1u
+#define SF_INPUT_BUTTON_RMB  0x2u
+
+typedef struct {
+    u32 magic;
+    u32 version;
+    u32 frame_count;  // Patched on close
+    u32 record_size;
+} sf_input_log_header;
+
+typedef struct {
+    f32 time;
+    f32 mouse_x;
+    f32 mouse_y;
+    i32 width;
+    i32 height;
+    u32 buttons;
+} sf_input_record;
+
+struct sf_input_log {
+    FILE* file;
+    bool  writing;
+    u32   frame_count;
+    u32   frame_index;
+};
+
+sf_input_log* sf_input_log_create(const char* path) {
+    if (!path) return NULL;
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        SF_LOG_ERROR("Host: Cannot create input log '%s'.", path);
+        return NULL;
+    }
+    sf_input_log_header head = { SF_INPUT_LOG_MAGIC, SF_INPUT_LOG_VERSION, 0, sizeof(sf_input_record) };
+    sf_input_log* log = calloc(1, sizeof(sf_input_log));
+    if (!log || fwrite(&head, sizeof(head), 1, f) != 1) {
+        fclose(f);
+        free(log);
+        return NULL;
+    }
+    log->file = f;
+    log->writing = true;
+    return log;
+}
+
+sf_input_log* sf_input_log_open(const char* path) {
+    if (!path) return NULL;
+    FILE* f = fopen(path, "rb");
+    if (!f) {
+        SF_LOG_ERROR("Host: Cannot open input log '%s'.", path);
+        return NULL;
+    }
+    sf_input_log_header head;
+    if (fread(&head, sizeof(head), 1, f) != 1 || head.magic != SF_INPUT_LOG_MAGIC ||
+        head.version != SF_INPUT_LOG_VERSION || head.record_size != sizeof(sf_input_record)) {
+        SF_LOG_ERROR("Host: '%s' is not a compatible input log.", path);
+        fclose(f);
+        return NULL;
+    }
+    sf_input_log* log = calloc(1, sizeof(sf_input_log));
+    if (!log) { fclose(f); return NULL; }
+    log->file = f;
+    log->frame_count = head.frame_count;
+    if (log->frame_count == 0 && fseek(f, 0, SEEK_END) == 0) {
+        long end = ftell(f);
+        if (end > (long)sizeof(head)) log->frame_count = (u32)((size_t)(end - (long)sizeof(head)) / sizeof(sf_input_record));
+        fseek(f, (long)sizeof(head), SEEK_SET);
+    }
+    return log;
+}
+
+bool sf_input_log_write(sf_input_log* log, const sf_host_inputs* inputs) {
+    if (!log || !log->writing || !inputs) return false;
+    sf_input_record rec = {
+        inputs->time, inputs->mouse_x, inputs->mouse_y, inputs->width, inputs->height,
+        (inputs->mouse_lmb ? SF_INPUT_BUTTON_LMB : 0u) | (inputs->mouse_rmb ? SF_INPUT_BUTTON_RMB : 0u)
+    };
+    if (fwrite(&rec, sizeof(rec), 1, log->file) != 1) return false;
+    log->frame_count++;
+    return true;
+}
+
+bool sf_input_log_read(sf_input_log* log, sf_host_inputs* out_inputs) {
+    if (!log || log->writing || !out_inputs || log->frame_index >= log->frame_count) return false;
+    sf_input_record rec;
+    if (fread(&rec, sizeof(rec), 1, log->file) != 1) return false;
+    log->frame_index++;
+
+    out_inputs->time = rec.time;
+    out_inputs->mouse_x = rec.mouse_x;
+    out_inputs->mouse_y = rec.mouse_y;
+    out_inputs->width = rec.width;
+    out_inputs->height = rec.height;
+    out_inputs->mouse_lmb = (rec.buttons & SF_INPUT_BUTTON_LMB) != 0;
+    out_inputs->mouse_rmb = (rec.buttons & SF_INPUT_BUTTON_RMB) != 0;
+    return true;
+}
+
+u32 sf_input_log_frame_count(const sf_input_log* log) {
+    return log ? log->frame_count : 0;
+}
+
+void sf_input_log_close(sf_input_log* log) {
+    if (!log) return;
+    if (log->writing) {
+        // An interrupted recording keeps frame_count 0; replay then counts records instead
+        fseek(log->file, (long)offsetof(sf_input_log_header, frame_count), SEEK_SET);
+        fwrite(&log->frame_count, sizeof(u32), 1, log->file);
+    }
+    fclose(log->file);
+    free(log);
+}
@@ -0,0 +1,44 @@
+#ifndef SF_INPUT_LOG_H
+#define SF_INPUT_LOG_H
+
+#include "sf_host_internal.h"
+
+/**
+ * Per-frame input recording (sf_host_inputs stream) for deterministic replay.
+ *
+ * File layout: sf_input_log_header followed by one fixed-size record per stepped frame.
+ */
+
+typedef struct sf_input_log sf_input_log;
+
+/**
+ * @brief Creates a log for recording. Returns NULL if the file cannot be created.
+ */
+sf_input_log*   sf_input_log_create(const char* path);
+
+/**
+ * @brief Opens a recorded log for replay. Returns NULL if missing or incompatible.
+ */
+sf_input_log*   sf_input_log_open(const char* path);
+
+/**
+ * @brief Appends the inputs of one frame.
+ */
+bool            sf_input_log_write(sf_input_log* log, const sf_host_inputs* inputs);
+
+/**
+ * @brief Reads the next frame's inputs. Returns false at the end of the log.
+ */
+bool            sf_input_log_read(sf_input_log* log, sf_host_inputs* out_inputs);
+
+/**
+ * @brief Number of frames in a log opened for replay.
+ */
+u32             sf_input_log_frame_count(const sf_input_log* log);
+
+/**
+ * @brief Finalizes (when recording) and closes the log.
+ */
+void            sf_input_log_close(sf_input_log* log);
+
+#endif // SF_INPUT_LOG_H
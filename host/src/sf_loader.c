@@ -1,4 +1,5 @@
 #include "sf_loader.h"
+#include "sf_codec.h"
 #include <sionflow/engine/sf_engine.h>
 #include <sionflow/isa/sf_opcodes.h>
 #include <sionflow/host/sf_host_desc.h>
@@ -24,6 +25,48 @@ static sf_program* _load_program_from_mem(const u8* data, size_t len, sf_arena*
     return prog;
 }
 
+/**
+ * Loads a program into a malloc'd block of its own (for sf_engine_adopt_program). The
+ * program loader's arena needs are not known up front, so the block grows until it fits.
+ */
+static sf_program* _load_program_block(const u8* data, size_t len, void** out_block) {
+    size_t cap = 2 * len + SF_KB(64);
+    for (int attempt = 0; attempt < 4; ++attempt, cap *= 2) {
+        void* block = malloc(cap);
+        if (!block) break;
+        sf_arena arena;
+        sf_arena_init(&arena, block, cap);
+        sf_program* prog = SF_ARENA_PUSH(&arena, sf_program, 1);
+        if (prog) {
+            memset(prog, 0, sizeof(sf_program));
+            if (sf_program_load_from_buffer(prog, data, len, &arena)) {
+                *out_block = block;
+                return prog;
+            }
+        }
+        free(block);
+    }
+    SF_LOG_ERROR("Failed to load program from buffer (SFC 2.0)");
+    return NULL;
+}
+
+static u32 _section_key(const char* name, u32 type) {
+    return sf_fnv1a_hash(name) ^ (type * 0x9E3779B9u);
+}
+
+static void _cartridge_build_index(sf_cartridge* cart) {
+    memset(cart->index_slot, 0, sizeof(cart->index_slot));
+    for (u32 i = 0; i < cart->header.section_count; ++i) {
+        sf_section_header* s = &cart->header.sections[i];
+        s->name[sizeof(s->name) - 1] = '\0';
+        u32 key = _section_key(s->name, s->type);
+        u32 slot = key & (SF_CARTRIDGE_INDEX_SIZE - 1);
+        while (cart->index_slot[slot]) slot = (slot + 1) & (SF_CARTRIDGE_INDEX_SIZE - 1);
+        cart->index_hash[slot] = key;
+        cart->index_slot[slot] = (u8)(i + 1);
+    }
+}
+
 sf_cartridge* sf_cartridge_open(const char* path) {
     size_t size = 0;
     void* data = sf_file_read_bin(path, &size);
@@ -35,46 +78,109 @@ sf_cartridge* sf_cartridge_open(const char* path) {
     }
 
     sf_cartridge_header* head = (sf_cartridge_header*)data;
-    if (head->magic != SF_BINARY_MAGIC) {
+    u32 max_sections = (u32)(sizeof(head->sections) / sizeof(head->sections[0]));
+    if (head->magic != SF_BINARY_MAGIC || head->section_count > max_sections) {
         free(data);
         return NULL;
     }
 
-    sf_cartridge* cart = malloc(sizeof(sf_cartridge));
+    sf_cartridge* cart = calloc(1, sizeof(sf_cartridge));
+    if (!cart) {
+        free(data);
+        return NULL;
+    }
     cart->data = data;
     cart->size = size;
     cart->header = *head;
+    _cartridge_build_index(cart);
     return cart;
 }
 
 void sf_cartridge_close(sf_cartridge* cart) {
     if (!cart) return;
+    for (u32 i = 0; i < SF_CARTRIDGE_MAX_SECTIONS; ++i) free(cart->unpacked[i]);
     free(cart->data);
     free(cart);
 }
 
-void* sf_cartridge_get_section(sf_cartridge* cart, const char* name, sf_section_type type, size_t* out_size) {
-    if (!cart) return NULL;
+static i32 _cartridge_find(const sf_cartridge* cart, const char* name, sf_section_type type) {
+    if (!cart || !name) return -1;
 
-    for (u32 i = 0; i < cart->header.section_count; ++i) {
-        sf_section_header* s = &cart->header.sections[i];
-        if (s->type == (u32)type && strcmp(s->name, name) == 0) {
-            if (s->offset + s->size > cart->size) return NULL;
-            if (out_size) *out_size = s->size;
-            return (u8*)cart->data + s->offset;
+    u32 key = _section_key(name, (u32)type);
+    for (u32 slot = key & (SF_CARTRIDGE_INDEX_SIZE - 1); cart->index_slot[slot]; slot = (slot + 1) & (SF_CARTRIDGE_INDEX_SIZE - 1)) {
+        if (cart->index_hash[slot] != key) continue;
+        const sf_section_header* s = &cart->header.sections[cart->index_slot[slot] - 1];
+        if (s->type == (u32)type && strcmp(s->name, name) == 0) return (i32)cart->index_slot[slot] - 1;
+    }
+    return -1;
+}
+
+// Stored bytes of a section (compressed or not)
+static const u8* _section_stored(const sf_cartridge* cart, i32 idx, size_t* out_size) {
+    const sf_section_header* s = &cart->header.sections[idx];
+    if ((u64)s->offset + s->size > cart->size) return NULL;
+    *out_size = s->size;
+    return (const u8*)cart->data + s->offset;
+}
+
+static void* _section_at(sf_cartridge* cart, i32 idx, size_t* out_size) {
+    size_t stored_size = 0;
+    const u8* stored = _section_stored(cart, idx, &stored_size);
+    if (!stored) return NULL;
+    if (!sf_codec_check(stored, stored_size)) {
+        if (out_size) *out_size = stored_size;
+        return (void*)stored;
+    }
+
+    size_t raw_size = 0;
+    if (!sf_codec_raw_size(stored, stored_size, &raw_size)) return NULL;
+    if (!cart->unpacked[idx]) {
+        void* raw = malloc(raw_size ? raw_size : 1);
+        if (!raw || !sf_codec_decode(stored, stored_size, raw, raw_size, 0)) {
+            SF_LOG_ERROR("Loader: Failed to decompress section '%s'", cart->header.sections[idx].name);
+            free(raw);
+            return NULL;
         }
+        cart->unpacked[idx] = raw;
     }
-    return NULL;
+    if (out_size) *out_size = raw_size;
+    return cart->unpacked[idx];
+}
+
+void* sf_cartridge_get_section(sf_cartridge* cart, const char* name, sf_section_type type, size_t* out_size) {
+    i32 idx = _cartridge_find(cart, name, type);
+    return idx < 0 ? NULL : _section_at(cart, idx, out_size);
+}
+
+bool sf_cartridge_section_size(sf_cartridge* cart, const char* name, sf_section_type type, size_t* out_size) {
+    i32 idx = _cartridge_find(cart, name, type);
+    size_t stored_size = 0;
+    const u8* stored = idx < 0 ? NULL : _section_stored(cart, idx, &stored_size);
+    if (!stored || !out_size) return false;
+    if (sf_codec_check(stored, stored_size)) return sf_codec_raw_size(stored, stored_size, out_size);
+    *out_size = stored_size;
+    return true;
+}
+
+bool sf_cartridge_read_section(sf_cartridge* cart, const char* name, sf_section_type type, void* dst, size_t dst_size) {
+    i32 idx = _cartridge_find(cart, name, type);
+    size_t stored_size = 0;
+    const u8* stored = idx < 0 ? NULL : _section_stored(cart, idx, &stored_size);
+    if (!stored || !dst) return false;
+    if (cart->unpacked[idx] || !sf_codec_check(stored, stored_size)) {
+        size_t size = 0;
+        const void* src = _section_at(cart, idx, &size);
+        if (!src || size != dst_size) return false;
+        memcpy(dst, src, size);
+        return true;
+    }
+    return sf_codec_decode(stored, stored_size, dst, dst_size, 0);
 }
 
 int sf_app_load_config(const char* path, sf_host_desc* out_desc) {
     if (!path || !out_desc) return -1;
     
-    // Initialize arena for descriptor strings and arrays
-    out_desc->arena_backing = malloc(SF_KB(128));
-    sf_arena_init(&out_desc->arena, out_desc->arena_backing, SF_KB(128));
-    sf_arena* arena = &out_desc->arena;
-
+    out_desc->arena_backing = NULL;
     sf_cartridge* cart = sf_cartridge_open(path);
     if (!cart) {
         SF_LOG_ERROR("Loader: Only binary .sfc/.bin cartridges are supported in production runtime.");
@@ -82,6 +188,22 @@ int sf_app_load_config(const char* path, sf_host_desc* out_desc) {
         return -1; 
     }
 
+    // A binary pipeline section is decoded without parsing; size the arena for it up front
+    size_t pipe_size = 0;
+    const char* pipe_section = (const char*)sf_cartridge_get_section(cart, "pipeline", SF_SECTION_PIPELINE, &pipe_size);
+    bool pipe_binary = pipe_section && sf_pipeline_bin_check(pipe_section, pipe_size);
+    size_t arena_size = SF_KB(128) + (pipe_binary ? sf_pipeline_bin_arena_size(pipe_section, pipe_size) : 0);
+
+    // Initialize arena for descriptor strings and arrays
+    out_desc->arena_backing = malloc(arena_size);
+    if (!out_desc->arena_backing) {
+        sf_cartridge_close(cart);
+        sf_host_desc_cleanup(out_desc);
+        return -1;
+    }
+    sf_arena_init(&out_desc->arena, out_desc->arena_backing, arena_size);
+    sf_arena* arena = &out_desc->arena;
+
     out_desc->window_title = sf_arena_strdup(arena, cart->header.app_title[0] ? cart->header.app_title : "SionFlow App");
     out_desc->width = cart->header.window_width ? (int)cart->header.window_width : 800;
     out_desc->height = cart->header.window_height ? (int)cart->header.window_height : 600;
@@ -91,11 +213,16 @@ int sf_app_load_config(const char* path, sf_host_desc* out_desc) {
     out_desc->num_threads = (int)cart->header.num_threads;
     out_desc->has_pipeline = true;
 
-    // Load full pipeline definition if available
-    size_t pipe_json_size = 0;
-    const char* pipe_json = (const char*)sf_cartridge_get_section(cart, "pipeline", SF_SECTION_PIPELINE, &pipe_json_size);
-    if (pipe_json) {
-        sf_json_value* root = sf_json_parse(pipe_json, arena);
+    // Load full pipeline definition if available (binary form, else JSON)
+    if (pipe_binary) {
+        if (!sf_pipeline_bin_decode(pipe_section, pipe_size, path, arena, &out_desc->pipeline)) {
+            SF_LOG_ERROR("Loader: Invalid binary pipeline section in '%s'", path);
+            sf_cartridge_close(cart);
+            sf_host_desc_cleanup(out_desc);
+            return -1;
+        }
+    } else if (pipe_section) {
+        sf_json_value* root = sf_json_parse(pipe_section, arena);
         if (root && root->type == SF_JSON_VAL_OBJECT) {
             const sf_json_value* pipe = sf_json_get_field(root, "pipeline");
             if (pipe && pipe->type == SF_JSON_VAL_OBJECT) {
@@ -114,6 +241,9 @@ int sf_app_load_config(const char* path, sf_host_desc* out_desc) {
                         const sf_json_value* v_ro = sf_json_get_field(r, "readonly");
                         const sf_json_value* v_ss = sf_json_get_field(r, "screen_size");
                         const sf_json_value* v_out = sf_json_get_field(r, "output");
+                        const sf_json_value* v_map = sf_json_get_field(r, "map");
+                        const sf_json_value* v_map_mode = sf_json_get_field(r, "map_mode");
+                        const sf_json_value* v_prefetch = sf_json_get_field(r, "prefetch");
 
                         dst->name = v_name ? sf_arena_strdup(arena, v_name->as.s) : "unknown";
                         dst->dtype = v_dtype ? sf_dtype_from_str(v_dtype->as.s) : SF_DTYPE_F32;
@@ -123,6 +253,16 @@ int sf_app_load_config(const char* path, sf_host_desc* out_desc) {
                         if (v_ss && v_ss->as.b) dst->flags |= SF_RESOURCE_FLAG_SCREEN_SIZE;
                         if (v_out && v_out->as.b) dst->flags |= SF_RESOURCE_FLAG_OUTPUT;
 
+                        // File-backed: "map": "data/volume.raw", "map_mode": "read" | "read_write"
+                        dst->map_flags = 0;
+                        dst->map_path = NULL;
+                        if (v_map && v_map->type == SF_JSON_VAL_STRING) {
+                            bool rw = v_map_mode && v_map_mode->type == SF_JSON_VAL_STRING && strcmp(v_map_mode->as.s, "read_write") == 0;
+                            dst->map_path = sf_arena_strdup(arena, v_map->as.s);
+                            dst->map_flags = rw ? (SF_RESOURCE_MAP_READ | SF_RESOURCE_MAP_WRITE) : SF_RESOURCE_MAP_READ;
+                            if (v_prefetch && v_prefetch->as.b) dst->map_flags |= SF_RESOURCE_MAP_PREFETCH;
+                        }
+
                         dst->ndim = 0;
                         if (v_shape && v_shape->type == SF_JSON_VAL_ARRAY) {
                             dst->ndim = (u8)v_shape->as.array.count;
@@ -141,11 +281,16 @@ int sf_app_load_config(const char* path, sf_host_desc* out_desc) {
                         sf_pipeline_kernel* dst = &out_desc->pipeline.kernels[i];
                         const sf_json_value* v_id = sf_json_get_field(k, "id");
                         const sf_json_value* v_freq = sf_json_get_field(k, "frequency");
+                        const sf_json_value* v_roi = sf_json_get_field(k, "roi_safe");
+                        const sf_json_value* v_elem = sf_json_get_field(k, "elementwise");
                         const sf_json_value* v_binds = sf_json_get_field(k, "bindings");
 
                         dst->id = v_id ? sf_arena_strdup(arena, v_id->as.s) : "kernel";
                         dst->graph_path = sf_arena_strdup(arena, path);
                         dst->frequency = v_freq ? (u32)v_freq->as.n : 1;
+                        dst->flags = 0;
+                        if (v_roi && v_roi->as.b) dst->flags |= SF_PIPELINE_KERNEL_ROI_SAFE;
+                        if (v_elem && v_elem->as.b) dst->flags |= SF_PIPELINE_KERNEL_ELEMENTWISE;
                         
                         if (v_binds && v_binds->type == SF_JSON_VAL_ARRAY) {
                             dst->binding_count = v_binds->as.array.count;
@@ -180,6 +325,7 @@ int sf_app_load_config(const char* path, sf_host_desc* out_desc) {
                 out_desc->pipeline.kernels[current_prog].id = sf_arena_strdup(arena, cart->header.sections[i].name);
                 out_desc->pipeline.kernels[current_prog].graph_path = sf_arena_strdup(arena, path); 
                 out_desc->pipeline.kernels[current_prog].frequency = 1;
+                out_desc->pipeline.kernels[current_prog].flags = 0;
                 out_desc->pipeline.kernels[current_prog].binding_count = 0;
                 out_desc->pipeline.kernels[current_prog].bindings = NULL;
                 current_prog++;
@@ -204,6 +350,10 @@ int sf_app_load_config(const char* path, sf_host_desc* out_desc) {
             out_desc->assets[cur_asset].path = sf_arena_strdup(arena, path); // Use cartridge as source
             out_desc->assets[cur_asset].type = (type == SF_SECTION_IMAGE) ? SF_ASSET_IMAGE : SF_ASSET_FONT;
             out_desc->assets[cur_asset].font_size = 32.0f;
+            // The cartridge path survives a rebuild; the section bytes tell whether the asset changed
+            size_t stored_size = 0;
+            const u8* stored = _section_stored(cart, (i32)i, &stored_size);
+            out_desc->assets[cur_asset].content_hash = stored ? sf_engine_hash_bytes(stored, stored_size) : 0;
             cur_asset++;
         }
     }
@@ -212,34 +362,68 @@ int sf_app_load_config(const char* path, sf_host_desc* out_desc) {
     return 0;
 }
 
-bool sf_loader_load_pipeline(sf_engine* engine, const sf_pipeline_desc* pipe) {
-    if (!engine || !pipe) return false;
-    sf_engine_reset(engine);
-    sf_arena* arena = sf_engine_get_arena(engine);
-    sf_program** programs = malloc(sizeof(sf_program*) * pipe->kernel_count);
+/**
+ * Loads the program for a pipeline kernel. With reuse set (hot reload), a program already
+ * bound with identical content is returned instead of loading a new copy, and new programs
+ * get their own block that the engine frees once a later reload replaces them. Otherwise
+ * programs go into the engine arena, reclaimed by the reset that precedes a full load.
+ */
+static sf_program* _load_kernel_program(sf_engine* engine, const sf_pipeline_kernel* kernel, bool reuse) {
+    sf_cartridge* cart = sf_cartridge_open(kernel->graph_path);
+    if (!cart) return NULL;
 
-    for (u32 i = 0; i < pipe->kernel_count; ++i) {
-        const char* path = pipe->kernels[i].graph_path;
-        sf_cartridge* cart = sf_cartridge_open(path);
-        if (!cart) { free(programs); return false; }
-        
-        size_t sec_size = 0;
-        void* sec_data = sf_cartridge_get_section(cart, pipe->kernels[i].id, SF_SECTION_PROGRAM, &sec_size);
-        if (sec_data) {
-            programs[i] = _load_program_from_mem(sec_data, sec_size, arena);
-        } else {
-            // Fallback: load first program found
-            for (u32 s = 0; s < cart->header.section_count; ++s) {
-                if (cart->header.sections[s].type == SF_SECTION_PROGRAM) {
-                    programs[i] = _load_program_from_mem((u8*)cart->data + cart->header.sections[s].offset, cart->header.sections[s].size, arena);
-                    break;
-                }
+    size_t sec_size = 0;
+    void* sec_data = sf_cartridge_get_section(cart, kernel->id, SF_SECTION_PROGRAM, &sec_size);
+    if (!sec_data) {
+        // Fallback: load first program found
+        for (u32 s = 0; s < cart->header.section_count; ++s) {
+            if (cart->header.sections[s].type == SF_SECTION_PROGRAM) {
+                sec_data = _section_at(cart, (i32)s, &sec_size);
+                break;
             }
         }
-        sf_cartridge_close(cart);
-        if (!programs[i]) { free(programs); return false; }
     }
 
+    sf_program* prog = NULL;
+    if (sec_data) {
+        u64 hash = sf_engine_hash_bytes(sec_data, sec_size);
+        if (reuse) prog = sf_engine_find_program(engine, hash);
+        if (!prog && reuse) {
+            void* block = NULL;
+            prog = _load_program_block(sec_data, sec_size, &block);
+            if (prog && !sf_engine_adopt_program(engine, prog, hash, block)) {
+                free(block);
+                prog = NULL;
+            }
+        } else if (!prog) {
+            prog = _load_program_from_mem(sec_data, sec_size, sf_engine_get_arena(engine));
+            if (prog) sf_engine_register_program(engine, prog, hash);
+        }
+    }
+    sf_cartridge_close(cart);
+    return prog;
+}
+
+static sf_program** _load_pipeline_programs(sf_engine* engine, const sf_pipeline_desc* pipe, bool reuse) {
+    sf_program** programs = malloc(sizeof(sf_program*) * (pipe->kernel_count + 1));
+    if (!programs) return NULL;
+    for (u32 i = 0; i < pipe->kernel_count; ++i) {
+        programs[i] = _load_kernel_program(engine, &pipe->kernels[i], reuse);
+        if (!programs[i]) {
+            SF_LOG_ERROR("Loader: Failed to load program for kernel '%s'", pipe->kernels[i].id);
+            free(programs);
+            return NULL;
+        }
+    }
+    return programs;
+}
+
+bool sf_loader_load_pipeline(sf_engine* engine, const sf_pipeline_desc* pipe) {
+    if (!engine || !pipe) return false;
+    sf_engine_reset(engine);
+    sf_program** programs = _load_pipeline_programs(engine, pipe, false);
+    if (!programs) return false;
+
     if (pipe->resource_count == 0) {
         const char** names = malloc(sizeof(char*) * pipe->kernel_count);
         for (u32 i = 0; i < pipe->kernel_count; ++i) names[i] = pipe->kernels[i].id;
@@ -251,4 +435,18 @@ bool sf_loader_load_pipeline(sf_engine* engine, const sf_pipeline_desc* pipe) {
     
     free(programs); 
     return true;
-}
\ No newline at end of file
+}
+
+bool sf_loader_reload_pipeline(sf_engine* engine, const sf_pipeline_desc* pipe) {
+    if (!engine || !pipe) return false;
+    // Cartridge-discovered resources have no declared layout to diff against
+    if (pipe->resource_count == 0) return sf_loader_load_pipeline(engine, pipe);
+
+    sf_program** programs = _load_pipeline_programs(engine, pipe, true);
+    bool ok = programs && sf_engine_reload_pipeline(engine, pipe, programs);
+    free(programs);
+    if (ok) return true;
+
+    SF_LOG_WARN("Loader: Incremental reload failed, falling back to a full pipeline load.");
+    return sf_loader_load_pipeline(engine, pipe);
+}
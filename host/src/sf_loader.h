@@ -22,17 +22,35 @@ int sf_app_load_config(const char* mfapp_path, sf_host_desc* out_desc);
 // --- Pipeline Loading ---
 bool            sf_loader_load_pipeline(sf_engine* engine, const sf_pipeline_desc* pipe);
 
+/**
+ * @brief Hot-reloads a pipeline, keeping unchanged kernels and resources (and their state).
+ * Falls back to a full load when an incremental re-bind is not possible.
+ */
+bool            sf_loader_reload_pipeline(sf_engine* engine, const sf_pipeline_desc* pipe);
+
+#define SF_CARTRIDGE_INDEX_SIZE   64u // Power of two, at least twice the header's section capacity
+#define SF_CARTRIDGE_MAX_SECTIONS (sizeof(((sf_cartridge_header*)0)->sections) / sizeof(sf_section_header))
+
+// Linear probing needs free slots to terminate, and slots store section + 1 in a u8
+_Static_assert(SF_CARTRIDGE_INDEX_SIZE >= 2 * SF_CARTRIDGE_MAX_SECTIONS && SF_CARTRIDGE_MAX_SECTIONS < 255,
+               "SF_CARTRIDGE_INDEX_SIZE too small for the header's section capacity");
+
 /**
  * @brief Simple view over a loaded cartridge file.
+ * Sections are found through an open-addressing index keyed by (name, type), built on open.
+ * Compressed sections (sf_codec) are decoded on first access and kept until close.
  */
 typedef struct {
     void* data;
     size_t size;
     sf_cartridge_header header;
+    u32 index_hash[SF_CARTRIDGE_INDEX_SIZE];
+    u8  index_slot[SF_CARTRIDGE_INDEX_SIZE]; // Section + 1, 0 = empty
+    void* unpacked[SF_CARTRIDGE_MAX_SECTIONS];
 } sf_cartridge;
 
 /**
- * @brief Opens a cartridge file and maps it into memory.
+ * @brief Opens a cartridge file and reads it into memory (whole file).
  */
 sf_cartridge*   sf_cartridge_open(const char* path);
 
@@ -42,10 +60,23 @@ sf_cartridge*   sf_cartridge_open(const char* path);
 void            sf_cartridge_close(sf_cartridge* cart);
 
 /**
- * @brief Extracts a specific section from a cartridge.
+ * @brief Extracts a specific section from a cartridge (hashed lookup).
+ * Compressed sections are returned decoded; out_size is the decoded size. The decoded
+ * copy is cached until close: prefer sf_cartridge_read_section for one-shot reads.
  */
 void*           sf_cartridge_get_section(sf_cartridge* cart, const char* name, sf_section_type type, size_t* out_size);
 
+/**
+ * @brief Decoded size of a section, without decoding it.
+ */
+bool            sf_cartridge_section_size(sf_cartridge* cart, const char* name, sf_section_type type, size_t* out_size);
+
+/**
+ * @brief Decodes a section straight into dst (dst_size must equal the decoded size), in parallel
+ * for compressed sections. Nothing is cached on the cartridge.
+ */
+bool            sf_cartridge_read_section(sf_cartridge* cart, const char* name, sf_section_type type, void* dst, size_t dst_size);
+
 bool            sf_loader_load_image(sf_engine* engine, const char* name, const char* path);
 bool            sf_loader_load_font(sf_engine* engine, const char* resource_name, const char* path, float font_size);
 